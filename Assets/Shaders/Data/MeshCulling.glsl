@@ -0,0 +1,44 @@
+// Bounds of freed and inactive slots, they are never drawn
+#define INVALID_DRAW_INDEX 0xFFFFFFFF
+
+struct MeshInstanceBounds
+{
+    // Center xyz, radius w
+    vec4 Sphere;
+    uint DrawIndex;
+    uint _padding0;
+    vec2 _padding1;
+};
+
+// Same layout as VkDrawIndexedIndirectCommand
+struct DrawIndexedCommand
+{
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int VertexOffset;
+    uint FirstInstance;
+};
+
+layout(std430, binding = 0) readonly buffer BoundsBuffer
+{
+    MeshInstanceBounds Bounds[];
+};
+
+layout(std430, binding = 1) buffer DrawCommandBuffer
+{
+    DrawIndexedCommand DrawCommands[];
+};
+
+layout(std430, binding = 2) writeonly buffer VisibleInstanceBuffer
+{
+    uint VisibleInstances[];
+};
+
+layout(push_constant) uniform u_CullData
+{
+    vec4 FrustumPlanes[6];
+    uint InstanceCount;
+    uint DrawCount;
+    vec2 _padding0;
+} CullData;
@@ -8,3 +8,9 @@ layout(std430, binding = 1) readonly buffer InstanceBuffer
     MeshInstance Instances[];
 };
 
+
+// Indices into Instances that survived culling, compacted per draw by CullMeshInstances.comp
+layout(std430, binding = 3) readonly buffer VisibleInstanceBuffer
+{
+    uint VisibleInstances[];
+};
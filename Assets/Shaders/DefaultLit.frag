@@ -1,8 +1,8 @@
 #version 450
 
-#include "Data\GlobalData.glsl"
-#include "Data\RenderMode.glsl"
-#include "Utils\Utils.glsl"
+#include "Data/GlobalData.glsl"
+#include "Data/RenderMode.glsl"
+#include "Utils/Utils.glsl"
 
 layout(set = 0, binding = 2) uniform sampler2D u_Texture;
 
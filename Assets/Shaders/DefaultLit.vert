@@ -1,9 +1,9 @@
 #version 450 core
 
-#include "Data\GlobalData.glsl"
-#include "Data\MeshInstance.glsl" 
-#include "Data\RenderMode.glsl"
-#include "Utils\Utils.glsl"
+#include "Data/GlobalData.glsl"
+#include "Data/MeshInstance.glsl" 
+#include "Data/RenderMode.glsl"
+#include "Utils/Utils.glsl"
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
@@ -15,7 +15,8 @@ layout(location = 2) out vec4 v_Color;
 
 void main()
 {
-    MeshInstance instance = Instances[gl_InstanceIndex];
+    // Instance index runs through the draw's region of visible instances
+    MeshInstance instance = Instances[VisibleInstances[gl_InstanceIndex]];
     gl_Position = GlobalData.PerspectiveViewProjection * instance.Model * vec4(a_Position, 1.0);
     v_UV = a_UV;
     v_Normal = mat3(instance.Model) * a_Normal;
@@ -1,7 +1,7 @@
 #version 450
 
-#include "Data\RenderMode.glsl"
-#include "Data\GlobalData.glsl"
+#include "Data/RenderMode.glsl"
+#include "Data/GlobalData.glsl"
 
 layout(input_attachment_index = 0, set = 0, binding = 3) uniform subpassInput u_FramebufferColor;
 layout(input_attachment_index = 1, set = 0, binding = 4) uniform subpassInput u_Depth;
@@ -1,6 +1,6 @@
 #version 450
 
-#include "Data\GlobalData.glsl"
+#include "Data/GlobalData.glsl"
 
 layout(location = 0) out vec2 v_UV;
 
@@ -1,6 +1,6 @@
 #version 450
 
-#include "Data\GlobalData.glsl"
+#include "Data/GlobalData.glsl"
 
 layout(set = 0, binding = 2) uniform sampler2D u_Texture;
 
@@ -4,8 +4,8 @@
 #define ONE_OVER_FONT_SIZE (1.0 / FONT_SIZE)
 #define ONE_OVER_BITMAP_SIZE (1.0 / 1024.0)
 
-#include "Data\GlobalData.glsl"
-#include "Data\GlyphInstance.glsl"
+#include "Data/GlobalData.glsl"
+#include "Data/GlyphInstance.glsl"
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
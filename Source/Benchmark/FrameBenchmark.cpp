@@ -0,0 +1,134 @@
+//
+// File: FrameBenchmark.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Benchmark/FrameBenchmark.hpp"
+
+namespace ThatEngine
+{
+    void FrameBenchmark::Init(const BenchmarkProperties& properties, const ECS::SystemManager& systems)
+    {
+        m_Properties = properties;
+        m_FrameIndex = 0;
+
+        m_CpuTimes.reserve(m_Properties.FrameCount);
+        m_GpuTimes.reserve(m_Properties.FrameCount);
+
+        m_SystemNames.resize(systems.GetSystemCount());
+        m_SystemTimes.resize(systems.GetSystemCount());
+        for (uint32_t i = 0; i < systems.GetSystemCount(); i++)
+        {
+            m_SystemNames[i] = systems.GetSystemStats(i).Name;
+            m_SystemTimes[i].reserve(m_Properties.FrameCount);
+        }
+
+        THAT_CORE_INFO("Benchmark: {} frames after {} warmup frames, {:.2f} ms timestep, {}x{} environment grid",
+            m_Properties.FrameCount, m_Properties.WarmupFrameCount, m_Properties.Timestep * 1000.0f, m_Properties.EnvironmentGridSize, m_Properties.EnvironmentGridSize);
+    }
+
+    void FrameBenchmark::RecordFrame(const StatsTracker& stats, const ECS::SystemManager& systems)
+    {
+        if (m_FrameIndex++ < m_Properties.WarmupFrameCount || IsFinished()) return;
+
+        m_CpuTimes.push_back(stats.GetCpuTime());
+        m_GpuTimes.push_back(stats.GetGpuTime());
+
+        for (uint32_t i = 0; i < m_SystemTimes.size(); i++)
+        {
+            m_SystemTimes[i].push_back(systems.GetSystemLastTime(i));
+        }
+    }
+
+    bool FrameBenchmark::WriteReport() const
+    {
+        if (m_CpuTimes.empty())
+        {
+            THAT_CORE_WARN("Benchmark: No frames were recorded, skipping report!");
+            return false;
+        }
+
+        bool isWritten = WriteFrameTimes(m_Properties.ReportPath + ".csv") && WriteSummary(m_Properties.ReportPath + ".json");
+
+        SampleSummary cpu = Summarize(m_CpuTimes);
+        SampleSummary gpu = Summarize(m_GpuTimes);
+        THAT_CORE_INFO("Benchmark: {} frames, CPU avg {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+            m_CpuTimes.size(), cpu.Average, cpu.P50, cpu.P95, cpu.P99, cpu.Max);
+        THAT_CORE_INFO("Benchmark: GPU avg {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+            gpu.Average, gpu.P50, gpu.P95, gpu.P99, gpu.Max);
+
+        return isWritten;
+    }
+
+    bool FrameBenchmark::WriteFrameTimes(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            THAT_CORE_ERROR("Benchmark: Failed to open \"{}\" for writing!", path);
+            return false;
+        }
+
+        file << "frame,cpu_ms,gpu_ms";
+        for (const std::string& name : m_SystemNames)
+        {
+            file << ",\"" << name << " ms\"";
+        }
+        file << '\n';
+
+        for (uint32_t frame = 0; frame < m_CpuTimes.size(); frame++)
+        {
+            file << frame << ',' << m_CpuTimes[frame] << ',' << m_GpuTimes[frame];
+            for (const std::vector<float>& times : m_SystemTimes)
+            {
+                file << ',' << times[frame];
+            }
+            file << '\n';
+        }
+
+        THAT_CORE_INFO("Benchmark: Wrote frame times to \"{}\"", path);
+        return file.good();
+    }
+
+    bool FrameBenchmark::WriteSummary(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            THAT_CORE_ERROR("Benchmark: Failed to open \"{}\" for writing!", path);
+            return false;
+        }
+
+        auto writeSummary = [&file](const SampleSummary& summary)
+        {
+            file << "{ \"avg\": " << summary.Average << ", \"min\": " << summary.Min << ", \"p50\": " << summary.P50
+                 << ", \"p95\": " << summary.P95 << ", \"p99\": " << summary.P99 << ", \"max\": " << summary.Max << " }";
+        };
+
+        file << "{\n";
+        file << "  \"frames\": " << m_CpuTimes.size() << ",\n";
+        file << "  \"warmup_frames\": " << m_Properties.WarmupFrameCount << ",\n";
+        file << "  \"timestep_ms\": " << m_Properties.Timestep * 1000.0f << ",\n";
+        file << "  \"environment_grid_size\": " << m_Properties.EnvironmentGridSize << ",\n";
+        file << "  \"headless\": " << (m_Properties.IsHeadless ? "true" : "false") << ",\n";
+        file << "  \"cpu_ms\": ";
+        writeSummary(Summarize(m_CpuTimes));
+        file << ",\n  \"gpu_ms\": ";
+        writeSummary(Summarize(m_GpuTimes));
+        file << ",\n  \"systems\": {";
+
+        for (uint32_t i = 0; i < m_SystemNames.size(); i++)
+        {
+            file << (i == 0 ? "\n" : ",\n") << "    \"" << m_SystemNames[i] << "\": ";
+            writeSummary(Summarize(m_SystemTimes[i]));
+        }
+
+        file << "\n  }\n}\n";
+
+        THAT_CORE_INFO("Benchmark: Wrote summary to \"{}\"", path);
+        return file.good();
+    }
+}
@@ -0,0 +1,54 @@
+//
+// File: FrameBenchmark.hpp
+// Description: Records frame and system times of a fixed number of frames,
+//              writes a per-frame CSV and a JSON summary with percentiles when the run ends
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/StatsTracker.hpp"
+#include "World/System/SystemManager.hpp"
+
+namespace ThatEngine
+{
+    struct BenchmarkProperties
+    {
+        uint32_t FrameCount = 1000;
+        uint32_t WarmupFrameCount = 60;         // Not recorded, lets caches, pools and the GPU settle
+        float Timestep = 1.0f / 60.0f;          // Fixed delta time of every frame, in seconds
+        uint32_t EnvironmentGridSize = 250;     // Only written to the report
+        bool IsHeadless = false;                // Only written to the report
+        std::string ReportPath = "BenchmarkReport"; // Extension is appended, .csv and .json
+    };
+
+    class FrameBenchmark
+    {
+        public:
+        FrameBenchmark() = default;
+        void Init(const BenchmarkProperties& properties, const ECS::SystemManager& systems);
+
+        // Call once per frame after the CPU measurement stopped
+        void RecordFrame(const StatsTracker& stats, const ECS::SystemManager& systems);
+        bool WriteReport() const;
+
+        inline bool IsFinished() const { return m_CpuTimes.size() >= m_Properties.FrameCount; }
+
+        static SampleSummary Summarize(std::vector<float> samples) { return SummarizeSamples(samples); }
+
+        private:
+        bool WriteFrameTimes(const std::string& path) const;
+        bool WriteSummary(const std::string& path) const;
+
+        private:
+        BenchmarkProperties m_Properties;
+        uint32_t m_FrameIndex = 0;
+
+        std::vector<float> m_CpuTimes;
+        std::vector<float> m_GpuTimes;                  // Measured when the frame's slot is reused, lags by the frames in flight
+        std::vector<std::string> m_SystemNames;
+        std::vector<std::vector<float>> m_SystemTimes;  // Indexed by system, then by frame
+    };
+}
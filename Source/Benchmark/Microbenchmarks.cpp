@@ -0,0 +1,196 @@
+//
+// File: Microbenchmarks.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Benchmark/Microbenchmarks.hpp"
+#include "Core/Timer.hpp"
+#include "Utils/GeometryUtils.hpp"
+
+#include <random>
+
+namespace ThatEngine
+{
+    namespace Benchmark
+    {
+        bool RunMicrobenchmarks(JobManager& jobs)
+        {
+            THAT_CORE_INFO("Microbenchmarks: Running...");
+
+            bool isPassed = RunJobSubmissionBenchmark(jobs);
+            isPassed &= RunFrustumCullingBenchmark();
+
+            if (!isPassed)
+            {
+                THAT_CORE_ERROR("Microbenchmarks: Failed!");
+                return false;
+            }
+
+            THAT_CORE_INFO("Microbenchmarks: Done!");
+            return true;
+        }
+
+        bool RunJobSubmissionBenchmark(JobManager& jobs)
+        {
+            constexpr uint32_t JOB_COUNT = 1000000;
+            constexpr uint32_t BATCH_SIZE = 1024;
+
+            std::atomic<uint32_t> executedCount = 0;
+            auto job = [&executedCount]() { executedCount.fetch_add(1, std::memory_order_relaxed); };
+
+            // Futures, one shared state and packaged task per job
+            float futureSeconds = 0.0f;
+            {
+                std::vector<std::future<void>> futures;
+                futures.reserve(BATCH_SIZE);
+
+                Timer timer;
+                for (uint32_t i = 0; i < JOB_COUNT; i += BATCH_SIZE)
+                {
+                    for (uint32_t j = 0; j < BATCH_SIZE; j++)
+                    {
+                        futures.push_back(jobs.Submit(job));
+                    }
+
+                    for (auto& future : futures)
+                    {
+                        future.get();
+                    }
+
+                    futures.clear();
+                }
+
+                futureSeconds = timer.GetElapsedTime().GetSeconds();
+            }
+
+            // Pooled jobs and a single counter per batch
+            float counterSeconds = 0.0f;
+            {
+                Timer timer;
+                for (uint32_t i = 0; i < JOB_COUNT; i += BATCH_SIZE)
+                {
+                    JobCounter counter;
+                    for (uint32_t j = 0; j < BATCH_SIZE; j++)
+                    {
+                        jobs.Run(job, counter);
+                    }
+
+                    jobs.Wait(counter);
+                }
+
+                counterSeconds = timer.GetElapsedTime().GetSeconds();
+            }
+
+            const uint32_t submittedCount = (JOB_COUNT + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+            // Checked in every build mode, throughput of a job system that loses jobs means nothing
+            if (executedCount != submittedCount * 2)
+            {
+                THAT_CORE_ERROR("Microbenchmarks: Expected {} executed jobs, got {}!", submittedCount * 2, executedCount.load());
+                return false;
+            }
+
+            THAT_CORE_INFO("Microbenchmarks: Job submission (Submit + future): {:.2f} M jobs/s", submittedCount / futureSeconds / 1000000.0f);
+            THAT_CORE_INFO("Microbenchmarks: Job submission (Run + counter): {:.2f} M jobs/s", submittedCount / counterSeconds / 1000000.0f);
+
+            return true;
+        }
+
+        bool RunFrustumCullingBenchmark()
+        {
+            constexpr uint32_t SPHERE_COUNT = 1000000;
+            constexpr uint32_t ITERATION_COUNT = 20;
+
+            // Camera in the middle of the spheres, so most of them get culled
+            glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            glm::mat4 projection = glm::perspectiveFovLH(glm::radians(90.0f), 1600.0f, 900.0f, 0.1f, 1000.0f);
+
+            Utils::Geometry::Plane frustumPlanes[6];
+            Utils::Geometry::ExtractFrustumPlanes(projection * view, frustumPlanes);
+
+            std::mt19937 random(1337);
+            std::uniform_real_distribution<float> positionDistribution(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> radiusDistribution(0.5f, 2.0f);
+
+            std::vector<glm::vec4> spheres(SPHERE_COUNT);
+            std::vector<float> centerX(SPHERE_COUNT), centerY(SPHERE_COUNT), centerZ(SPHERE_COUNT), radius(SPHERE_COUNT);
+            for (uint32_t i = 0; i < SPHERE_COUNT; i++)
+            {
+                spheres[i] = glm::vec4(positionDistribution(random), positionDistribution(random), positionDistribution(random), radiusDistribution(random));
+                centerX[i] = spheres[i].x;
+                centerY[i] = spheres[i].y;
+                centerZ[i] = spheres[i].z;
+                radius[i] = spheres[i].w;
+            }
+
+            std::vector<uint32_t> visibilityMask((SPHERE_COUNT + 31) / 32);
+            std::vector<uint32_t> visibleIndices(SPHERE_COUNT);
+
+            // One call per sphere, same as the transform system used to do
+            uint32_t scalarVisibleCount = 0;
+            float scalarSeconds = 0.0f;
+            {
+                Timer timer;
+                for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++)
+                {
+                    scalarVisibleCount = 0;
+                    for (uint32_t i = 0; i < SPHERE_COUNT; i++)
+                    {
+                        scalarVisibleCount += Utils::Geometry::IsSphereInsideFrustum(glm::vec3(spheres[i]), spheres[i].w, frustumPlanes);
+                    }
+                }
+
+                scalarSeconds = timer.GetElapsedTime().GetSeconds();
+            }
+
+            // Batched, visibility bitmask
+            uint32_t maskVisibleCount = 0;
+            float maskSeconds = 0.0f;
+            {
+                Timer timer;
+                for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++)
+                {
+                    Utils::Geometry::CullSpheres(centerX.data(), centerY.data(), centerZ.data(), radius.data(), SPHERE_COUNT, frustumPlanes, visibilityMask.data());
+                }
+
+                maskSeconds = timer.GetElapsedTime().GetSeconds();
+
+                for (uint32_t word : visibilityMask)
+                {
+                    maskVisibleCount += static_cast<uint32_t>(std::popcount(word));
+                }
+            }
+
+            // Batched, compacted indices
+            uint32_t compactVisibleCount = 0;
+            float compactSeconds = 0.0f;
+            {
+                Timer timer;
+                for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++)
+                {
+                    compactVisibleCount = Utils::Geometry::CullSpheresCompact(centerX.data(), centerY.data(), centerZ.data(), radius.data(), SPHERE_COUNT, frustumPlanes, visibleIndices.data());
+                }
+
+                compactSeconds = timer.GetElapsedTime().GetSeconds();
+            }
+
+            // Checked in every build mode, a fast kernel that culls the wrong spheres is not worth timing
+            if (scalarVisibleCount != maskVisibleCount || scalarVisibleCount != compactVisibleCount)
+            {
+                THAT_CORE_ERROR("Microbenchmarks: Culling results differ, scalar {}, mask {}, compact {}!", scalarVisibleCount, maskVisibleCount, compactVisibleCount);
+                return false;
+            }
+
+            const float sphereCount = static_cast<float>(SPHERE_COUNT) * ITERATION_COUNT;
+            const float bytesPerSphere = 4.0f * sizeof(float);
+            THAT_CORE_INFO("Microbenchmarks: Frustum culling {} spheres, {} visible, {} SIMD lanes", SPHERE_COUNT, scalarVisibleCount, Utils::Simd::LANE_COUNT);
+            THAT_CORE_INFO("Microbenchmarks: Frustum culling (per sphere): {:.1f} M spheres/s, {:.2f} GB/s", sphereCount / scalarSeconds / 1000000.0f, sphereCount * bytesPerSphere / scalarSeconds / 1e9f);
+            THAT_CORE_INFO("Microbenchmarks: Frustum culling (batched mask): {:.1f} M spheres/s, {:.2f} GB/s", sphereCount / maskSeconds / 1000000.0f, sphereCount * bytesPerSphere / maskSeconds / 1e9f);
+            THAT_CORE_INFO("Microbenchmarks: Frustum culling (batched indices): {:.1f} M spheres/s, {:.2f} GB/s", sphereCount / compactSeconds / 1000000.0f, sphereCount * bytesPerSphere / compactSeconds / 1e9f);
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,26 @@
+//
+// File: Microbenchmarks.hpp
+// Description: Small isolated benchmarks for engine internals, run at startup when built with MICROBENCHMARKS
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/JobManager.hpp"
+
+namespace ThatEngine
+{
+    namespace Benchmark
+    {
+        // Returns false if any benchmark produced wrong results
+        bool RunMicrobenchmarks(JobManager& jobs);
+
+        // Compares future based Submit against counter based Run in jobs per second, fails if a job was lost
+        bool RunJobSubmissionBenchmark(JobManager& jobs);
+
+        // Compares per-sphere frustum tests against the batched SIMD kernel in spheres per second, fails if their results differ
+        bool RunFrustumCullingBenchmark();
+    }
+}
@@ -8,8 +8,16 @@
 #include "Core/PCH.hpp"
 #include "Core/Application.hpp"
 #include "Core/Event/EventDispatcher.hpp"
+#include "Core/FrameAllocator.hpp"
+#include "Core/MemoryTracker.hpp"
 #include "Utils/MemoryUtils.hpp"
 
+#include <charconv>
+
+#ifdef MICROBENCHMARKS
+#include "Benchmark/Microbenchmarks.hpp"
+#endif
+
 namespace ThatEngine
 {
     Application::Application()
@@ -18,18 +26,32 @@ namespace ThatEngine
         m_IsRunning = true;
     }
 
-    bool Application::Init()
+    bool Application::Init(int argc, char** argv)
     {
         Log::Get().Init();
+        ParseCommandLine(argc, argv);
+        m_StatsTracker.SetHitchFactor(m_Options.HitchFactor);
 
         m_Jobs = CreateUnique<JobManager>();
         m_Jobs->Init();
 
+        FrameAllocator::Get().Init(m_Jobs->GetThreadCount() + 1);
+
+        #ifdef MICROBENCHMARKS
+        if (!Benchmark::RunMicrobenchmarks(*m_Jobs))
+        {
+            m_Jobs->Shutdown();
+            return false;
+        }
+        #endif
+
         WindowProperties properties = {};
         properties.Title = "Voxadion";
         properties.InnerWidth = 1600;
         properties.InnerHeight = 900;
         properties.IsFocused = false;
+        properties.IsHeadless = m_Options.IsHeadless;
+        properties.InputScriptPath = m_Options.InputScriptPath;
         
         m_Window = Window::Create(properties);
         m_Window->SetWindowEventCallback(BIND_EVENT_FN(Application::OnEvent));
@@ -38,11 +60,37 @@ namespace ThatEngine
         
         m_Resources = CreateUnique<ResourceManager>();
         
+        RendererProperties rendererProperties = {};
+        rendererProperties.FramesInFlight = 2;
+        rendererProperties.IsHeadless = m_Options.IsHeadless;
+        rendererProperties.ReadbackFrames = m_Options.ReadbackFrames;
+        rendererProperties.CollectPipelineStatistics = m_Options.CollectPipelineStatistics;
+
         m_Renderer = CreateUnique<Renderer>();
-        m_Renderer->Init(m_Window.get(), m_Resources.get(), m_StatsTracker);
+        if (!m_Renderer->Init(m_Window.get(), m_Resources.get(), m_Jobs.get(), m_StatsTracker, rendererProperties))
+        {
+            m_Jobs->Shutdown();
+            return false;
+        }
+
+        WorldProperties worldProperties = {};
+        worldProperties.EnvironmentGridSize = m_Options.EnvironmentGridSize;
+        worldProperties.UseCameraPath = m_Options.IsBenchmark;
 
         m_World = CreateUnique<World>();
-        m_World->Init(m_Window.get(), m_Resources.get(), m_Jobs.get(), m_Renderer.get(), m_StatsTracker);
+        m_World->Init(m_Window.get(), m_Resources.get(), m_Jobs.get(), m_Renderer.get(), m_StatsTracker, worldProperties);
+
+        if (m_Options.IsBenchmark)
+        {
+            m_Benchmark = CreateUnique<FrameBenchmark>();
+            m_Benchmark->Init(m_Options.Benchmark, m_World->GetSystemManager());
+        }
+
+        if (!BuildFrameGraph())
+        {
+            m_Jobs->Shutdown();
+            return false;
+        }
 
         return true;
     }
@@ -55,26 +103,236 @@ namespace ThatEngine
         {
             m_StatsTracker.StartCpuMeasurement();
 
-            // Tracking
+            // Transient data of the previous frame is no longer referenced by anything
+            FrameAllocator::Get().Reset();
+
+            // Stats keep the measured time even when the simulation steps by a fixed one
+            const Timestep frameTime = m_Timer.GetDeltaTime();
+            m_DeltaTime = frameTime;
+            if (m_Options.FixedTimestep > 0.0f)
+            {
+                m_DeltaTime = Timestep(m_Options.FixedTimestep);
+            }
+
+            m_FrameGraph.Execute(*m_Jobs);
+
+            #ifdef ALLOCATION_TRACKING
+            UpdateAllocationStats();
+            #endif
+
+            m_StatsTracker.StopCpuMeasurement();
+            m_StatsTracker.EndFrame(frameTime.GetMilliseconds());
+
+            if (m_StatsTracker.ConsumeDumpRequest())
+            {
+                m_StatsTracker.DumpToFile(StatsTracker::DEFAULT_DUMP_PATH);
+            }
+
+            if (m_Benchmark)
+            {
+                m_Benchmark->RecordFrame(m_StatsTracker, m_World->GetSystemManager());
+                if (m_Benchmark->IsFinished()) Close();
+            }
+        }
+
+        if (m_Benchmark)
+        {
+            m_Benchmark->WriteReport();
+        }
+
+        if (!m_Options.StatsDumpPath.empty())
+        {
+            m_StatsTracker.DumpToFile(m_Options.StatsDumpPath);
+        }
+
+        m_Jobs->Shutdown();
+        m_Renderer->Shutdown();
+        FrameAllocator::Get().Shutdown();
+    }
+
+    void Application::ParseCommandLine(int argc, char** argv)
+    {
+        float benchmarkSeconds = 0.0f;
+
+        // Numeric value following the argument, a missing or malformed value is reported and the default is kept
+        auto parseValue = [&](int& i, auto& value)
+        {
+            if (i + 1 >= argc)
+            {
+                THAT_CORE_WARN("Application: Command line argument '{}' is missing its value", argv[i]);
+                return;
+            }
+
+            const char* begin = argv[++i];
+            const char* end = begin + std::strlen(begin);
+            auto parsed = value;
+            auto [pointer, error] = std::from_chars(begin, end, parsed);
+
+            if (error == std::errc() && pointer == end)
+            {
+                value = parsed;
+            }
+
+            else
+            {
+                THAT_CORE_WARN("Application: Invalid value '{}' for command line argument '{}'", begin, argv[i - 1]);
+            }
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--headless")
+            {
+                m_Options.IsHeadless = true;
+            }
+
+            else if (argument == "--readback")
+            {
+                m_Options.ReadbackFrames = true;
+            }
+
+            else if (argument == "--pipeline-statistics")
+            {
+                m_Options.CollectPipelineStatistics = true;
+            }
+
+            else if (argument == "--input-script" && i + 1 < argc)
+            {
+                m_Options.InputScriptPath = argv[++i];
+            }
+
+            else if (argument == "--fixed-timestep")
+            {
+                parseValue(i, m_Options.FixedTimestep);
+            }
+
+            else if (argument == "--grid-size")
+            {
+                parseValue(i, m_Options.EnvironmentGridSize);
+            }
+
+            else if (argument == "--benchmark")
+            {
+                m_Options.IsBenchmark = true;
+            }
+
+            else if (argument == "--benchmark-frames")
+            {
+                parseValue(i, m_Options.Benchmark.FrameCount);
+            }
+
+            else if (argument == "--benchmark-seconds")
+            {
+                parseValue(i, benchmarkSeconds);
+            }
+
+            else if (argument == "--benchmark-warmup")
+            {
+                parseValue(i, m_Options.Benchmark.WarmupFrameCount);
+            }
+
+            else if (argument == "--benchmark-report" && i + 1 < argc)
+            {
+                m_Options.Benchmark.ReportPath = argv[++i];
+            }
+
+            else if (argument == "--stats-dump" && i + 1 < argc)
+            {
+                m_Options.StatsDumpPath = argv[++i];
+            }
+
+            else if (argument == "--hitch-factor")
+            {
+                parseValue(i, m_Options.HitchFactor);
+            }
+
+            else
+            {
+                THAT_CORE_WARN("Application: Unknown command line argument '{}'", argument);
+            }
+        }
+
+        #ifndef PLATFORM_WINDOWS
+        // No native window implementation on other platforms
+        m_Options.IsHeadless = true;
+        #endif
+
+        if (m_Options.ReadbackFrames && !m_Options.IsHeadless)
+        {
+            THAT_CORE_WARN("Application: Frames are only read back when rendering headless!");
+        }
+
+        m_Options.EnvironmentGridSize = glm::max(m_Options.EnvironmentGridSize, 1u);
+        m_Options.HitchFactor = glm::max(m_Options.HitchFactor, 1.0f);
+
+        // Benchmarks always step by the same time, so every run simulates the same frames
+        if (m_Options.IsBenchmark)
+        {
+            if (m_Options.FixedTimestep <= 0.0f)
+            {
+                m_Options.FixedTimestep = m_Options.Benchmark.Timestep;
+            }
+
+            if (benchmarkSeconds > 0.0f)
+            {
+                m_Options.Benchmark.FrameCount = static_cast<uint32_t>(glm::ceil(benchmarkSeconds / m_Options.FixedTimestep));
+            }
+
+            m_Options.Benchmark.Timestep = m_Options.FixedTimestep;
+            m_Options.Benchmark.EnvironmentGridSize = m_Options.EnvironmentGridSize;
+            m_Options.Benchmark.IsHeadless = m_Options.IsHeadless;
+        }
+
+    }
+
+    bool Application::BuildFrameGraph()
+    {
+        // Tracking, does not touch anything the window needs so it overlaps with event processing
+        TaskId memory = m_FrameGraph.AddTask("Update Memory Usage", [this]()
+        {
             UpdateMemoryUsage();
-            
-            // Calculations
-            Timestep deltaTime = m_Timer.GetDeltaTime();
+        });
+
+        // Window messages have to be processed by the thread that created the window
+        TaskId window = m_FrameGraph.AddTask("Update Window", [this]()
+        {
             m_Window->Update();
-            m_World->Update(deltaTime);
-            
-            // Input handling
+        }, TaskAffinity::MainThread);
+
+        // Calculations
+        TaskId world = m_FrameGraph.AddTask("Update World", [this]()
+        {
+            m_World->Update(m_DeltaTime);
+        }, TaskAffinity::MainThread);
+
+        // Input handling
+        TaskId input = m_FrameGraph.AddTask("Handle Input", [this]()
+        {
             HandleCursorLock();
             Input::Get().Restore();
+        }, TaskAffinity::MainThread);
 
-            // Rendering
+        // Rendering
+        TaskId render = m_FrameGraph.AddTask("Render World", [this]()
+        {
             m_World->Render();
+        }, TaskAffinity::MainThread);
 
-            m_StatsTracker.StopCpuMeasurement();
+        m_FrameGraph.AddDependency(memory, world);
+        m_FrameGraph.AddDependency(window, world);
+        m_FrameGraph.AddDependency(world, input);
+        m_FrameGraph.AddDependency(input, render);
+
+        // Running a graph with a cycle would wait forever on tasks that can never start
+        if (!m_FrameGraph.Build())
+        {
+            THAT_CORE_ERROR("Application: Failed to build frame graph!");
+            return false;
         }
 
-        m_Jobs->Shutdown();
-        m_Renderer->Shutdown();
+        return true;
     }
 
     void Application::Close()
@@ -107,12 +365,44 @@ namespace ThatEngine
         float elapsedTime = m_Timer.GetElapsedTime().GetSeconds();
         if (elapsedTime < m_UpdateMemoryUsageTime) return;
         
-        float memoryUsage = Utils::Memory::GetCurrentProcessMemoryUsage();
-        m_StatsTracker.SetRamUsage(memoryUsage); 
+        Utils::Memory::ProcessMemoryInfo memoryInfo = Utils::Memory::GetCurrentProcessMemoryInfo();
+        m_StatsTracker.SetProcessMemory(memoryInfo); 
+
+        TracyPlot("Resident Memory", memoryInfo.Resident);
+        TracyPlot("Proportional Memory", memoryInfo.Proportional);
 
         m_UpdateMemoryUsageTime = elapsedTime + 0.5f;
     }
 
+    #ifdef ALLOCATION_TRACKING
+    void Application::UpdateAllocationStats()
+    {
+        MemoryTracker::EndFrame();
+        m_StatsTracker.SetFrameAllocationStats(MemoryTracker::GetFrameStats());
+
+        TracyPlot("Frame Allocations", static_cast<int64_t>(MemoryTracker::GetFrameStats().AllocationCount));
+        TracyPlot("Frame Allocated Bytes", static_cast<int64_t>(MemoryTracker::GetFrameStats().ByteCount));
+        TracyPlot("Live Heap Bytes", MemoryTracker::GetLiveByteCount());
+
+        // Rate limited per tag breakdown of frames that allocate way more than a steady frame should
+        float elapsedTime = m_Timer.GetElapsedTime().GetSeconds();
+        if (MemoryTracker::GetFrameStats().AllocationCount < ALLOCATION_STORM_THRESHOLD || elapsedTime < m_AllocationWarningTime) return;
+
+        THAT_CORE_WARN("Application: {} allocations ({:.2f} KB) in one frame, {:.2f} MB live on the heap", 
+            MemoryTracker::GetFrameStats().AllocationCount, MemoryTracker::GetFrameStats().ByteCount / 1024.0f, MemoryTracker::GetLiveByteCount() / (1024.0f * 1024.0f));
+
+        for (uint32_t i = 0; i < MemoryTracker::TAG_COUNT; i++)
+        {
+            const AllocationStats& stats = MemoryTracker::GetFrameStats(static_cast<AllocationTag>(i));
+            if (stats.AllocationCount == 0) continue;
+
+            THAT_CORE_WARN("Application:     {}: {} allocations ({:.2f} KB)", ToString(static_cast<AllocationTag>(i)), stats.AllocationCount, stats.ByteCount / 1024.0f);
+        }
+
+        m_AllocationWarningTime = elapsedTime + 5.0f;
+    }
+    #endif
+
     void Application::OnEvent(Event& event)
     {
         EventDispatcher dispatcher(event);
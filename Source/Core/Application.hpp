@@ -14,6 +14,7 @@
 #include "Core/Window.hpp"
 #include "Core/Input.hpp"
 #include "Core/JobManager.hpp"
+#include "Core/Job/TaskGraph.hpp"
 #include "Core/StatsTracker.hpp"
 #include "Core/Event/WindowEvent.hpp"
 #include "Core/Event/MouseEvent.hpp"
@@ -23,23 +24,47 @@
 #include "World/World.hpp"
 #include "Renderer/ResourceManager.hpp"
 #include "Renderer/Renderer.hpp"
+#include "Benchmark/FrameBenchmark.hpp"
 
 namespace ThatEngine
 {
+    // Set from the command line
+    struct ApplicationOptions
+    {
+        bool IsHeadless = false;        // --headless
+        bool ReadbackFrames = false;    // --readback, checksums every headless frame
+        bool CollectPipelineStatistics = false; // --pipeline-statistics
+        std::string InputScriptPath;    // --input-script <path>, replayed by the headless window
+        float FixedTimestep = 0.0f;     // --fixed-timestep <seconds>, 0 uses measured frame time
+        uint32_t EnvironmentGridSize = 250; // --grid-size <n>
+        std::string StatsDumpPath;      // --stats-dump <path>, counter history, frame time histogram and hitches written on exit
+        float HitchFactor = StatsTracker::DEFAULT_HITCH_FACTOR; // --hitch-factor <n>, frames over n times the median count as hitches
+
+        // --benchmark, camera follows a path for a fixed number of frames, then a report is written and the application closes
+        bool IsBenchmark = false;
+        BenchmarkProperties Benchmark;  // --benchmark-frames <n>, --benchmark-seconds <s>, --benchmark-warmup <n>, --benchmark-report <path>
+    };
+
     class Application : public Singleton<Application>
     {
         friend class Singleton<Application>;
 
         public:
         Application();
-        bool Init();
+        bool Init(int argc, char** argv);
         void Run();
         void Close();
 
         private:
+        void ParseCommandLine(int argc, char** argv);
+        bool BuildFrameGraph();
         void HandleCursorLock();
         void UpdateMemoryUsage();
 
+        #ifdef ALLOCATION_TRACKING
+        void UpdateAllocationStats();
+        #endif
+
         void OnEvent(Event& event);
         bool OnWindowClose(WindowCloseEvent& event);
         bool OnWindowMove(WindowMoveEvent& event);
@@ -53,11 +78,21 @@ namespace ThatEngine
         Unique<ResourceManager> m_Resources;
         Unique<Renderer> m_Renderer;
         Unique<World> m_World;
+        Unique<FrameBenchmark> m_Benchmark;
+        ApplicationOptions m_Options;
+
+        TaskGraph m_FrameGraph;
+        Timestep m_DeltaTime;
 
         StatsTracker m_StatsTracker;
         Timer m_Timer;
         bool m_IsRunning;
         
         float m_UpdateMemoryUsageTime;
+
+        #ifdef ALLOCATION_TRACKING
+        static constexpr uint64_t ALLOCATION_STORM_THRESHOLD = 1000;
+        float m_AllocationWarningTime = 0.0f;
+        #endif
     };
 }
\ No newline at end of file
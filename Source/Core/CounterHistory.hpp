@@ -0,0 +1,86 @@
+//
+// File: CounterHistory.hpp
+// Description: Lock-free ring buffer of the most recent samples of a named counter,
+//              summarized into mean, min, max and percentiles over a rolling window
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+#include "Core/RollingStatistics.hpp"
+
+namespace ThatEngine
+{
+    using CounterId = uint32_t;
+
+    struct CounterSummary : SampleSummary
+    {
+        float Last;
+    };
+
+    // Only one thread may add samples to a counter, any thread may read it at the same time
+    class CounterHistory
+    {
+        public:
+        static constexpr uint32_t CAPACITY = 1024;
+        static constexpr uint32_t DEFAULT_WINDOW_SIZE = 240;
+
+        public:
+        CounterHistory(std::string_view name) : m_Name(name) {}
+
+        CounterHistory(const CounterHistory&) = delete;
+        CounterHistory& operator=(const CounterHistory&) = delete;
+
+        void AddSample(float value)
+        {
+            const uint64_t writeCount = m_WriteCount.load(std::memory_order_relaxed);
+            m_Samples[writeCount % CAPACITY].store(value, std::memory_order_relaxed);
+            m_WriteCount.store(writeCount + 1, std::memory_order_release);
+        }
+
+        // Copies up to maxCount of the most recent samples, oldest first, returns how many were copied.
+        // Samples the writer overwrites during the copy come out newer than their neighbours, which statistics do not mind
+        uint32_t CopySamples(float* samples, uint32_t maxCount) const
+        {
+            const uint64_t writeCount = m_WriteCount.load(std::memory_order_acquire);
+            const uint32_t count = static_cast<uint32_t>(glm::min<uint64_t>(glm::min(maxCount, CAPACITY), writeCount));
+
+            const uint64_t first = writeCount - count;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                samples[i] = m_Samples[(first + i) % CAPACITY].load(std::memory_order_relaxed);
+            }
+
+            return count;
+        }
+
+        // Summary of the last windowSize samples
+        CounterSummary GetSummary(uint32_t windowSize = DEFAULT_WINDOW_SIZE) const
+        {
+            std::array<float, CAPACITY> samples;
+            const uint32_t count = CopySamples(samples.data(), windowSize);
+
+            if (count == 0) return {};
+
+            const float last = samples[count - 1];
+            return { SummarizeSamples(std::span<float>(samples.data(), count)), last };
+        }
+
+        inline float GetLast() const
+        {
+            const uint64_t writeCount = m_WriteCount.load(std::memory_order_acquire);
+            return writeCount ? m_Samples[(writeCount - 1) % CAPACITY].load(std::memory_order_relaxed) : 0.0f;
+        }
+
+        inline const std::string& GetName() const { return m_Name; }
+        inline uint64_t GetTotalSampleCount() const { return m_WriteCount.load(std::memory_order_acquire); }
+
+        private:
+        const std::string m_Name;
+        std::array<std::atomic<float>, CAPACITY> m_Samples = {};
+        std::atomic<uint64_t> m_WriteCount = 0;
+    };
+}
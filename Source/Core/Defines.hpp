@@ -13,4 +13,10 @@
 #define SIZE_KB(x) ((uint32_t)x * 1024)
 #define SIZE_MB(x) (SIZE_KB(x) * 1024)
 #define SIZE_GB(x) (SIZE_MB(x) * 1024)
-#define INVALID_UINT32_ID UINT32_MAX
\ No newline at end of file
+#define INVALID_UINT32_ID UINT32_MAX
+
+#ifdef PLATFORM_WINDOWS
+#define DEBUG_BREAK() __debugbreak()
+#else
+#define DEBUG_BREAK() __builtin_trap()
+#endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+//
+// File: FrameAllocator.hpp
+// Description: Linear allocator for transient data that only lives for one frame,
+//              every job thread bumps its own sub-arena and everything is released at once on Reset
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+#include "Core/Pattern/Singleton.hpp"
+#include "Core/JobManager.hpp"
+
+#include <memory_resource>
+
+namespace ThatEngine
+{
+    // std::pmr adapter, deallocation is a no-op since memory goes away with the frame
+    class FrameMemoryResource : public std::pmr::memory_resource
+    {
+        private:
+        void* do_allocate(size_t size, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t size, size_t alignment) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    class FrameAllocator : public Singleton<FrameAllocator>
+    {
+        friend class Singleton<FrameAllocator>;
+
+        public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = SIZE_MB(4);
+
+        public:
+        // One sub-arena per job thread index, plus a locked one for threads outside of the job system
+        void Init(uint32_t threadCount, size_t blockSize = DEFAULT_BLOCK_SIZE)
+        {
+            m_BlockSize = blockSize;
+            m_Arenas = std::vector<Arena>(threadCount + 1);
+        }
+
+        void Shutdown()
+        {
+            m_Arenas.clear();
+        }
+
+        // Everything allocated since the last reset becomes invalid, blocks are kept for the next frame
+        void Reset()
+        {
+            size_t usedBytes = 0;
+            for (auto& arena : m_Arenas)
+            {
+                usedBytes += arena.UsedBytes;
+
+                arena.CurrentBlock = 0;
+                arena.Offset = 0;
+                arena.UsedBytes = 0;
+            }
+
+            m_LastFrameUsedBytes = usedBytes;
+        }
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            uint32_t threadIndex = JobManager::GetCurrentThreadIndex();
+
+            // Foreign threads share the last arena
+            if (threadIndex >= m_Arenas.size() - 1)
+            {
+                std::lock_guard<std::mutex> lock(m_SharedArenaMutex);
+                return AllocateFromArena(m_Arenas.back(), size, alignment);
+            }
+
+            return AllocateFromArena(m_Arenas[threadIndex], size, alignment);
+        }
+
+        // Constructs an object in the arena, its destructor is never called
+        template<typename T, typename... Args>
+        T* Create(Args&&... args)
+        {
+            void* memory = Allocate(sizeof(T), alignof(T));
+            return new (memory) T(std::forward<Args>(args)...);
+        }
+
+        static inline std::pmr::memory_resource* GetResource() { return &Get().m_Resource; }
+        inline size_t GetLastFrameUsedBytes() const { return m_LastFrameUsedBytes; }
+
+        private:
+        FrameAllocator() = default;
+
+        struct Block
+        {
+            Unique<std::byte[]> Memory;
+            size_t Size;
+        };
+
+        struct alignas(64) Arena
+        {
+            std::vector<Block> Blocks;
+            uint32_t CurrentBlock = 0;
+            size_t Offset = 0;
+            size_t UsedBytes = 0;
+        };
+
+        void* AllocateFromArena(Arena& arena, size_t size, size_t alignment)
+        {
+            while (arena.CurrentBlock < arena.Blocks.size())
+            {
+                Block& block = arena.Blocks[arena.CurrentBlock];
+                uintptr_t base = reinterpret_cast<uintptr_t>(block.Memory.get());
+                size_t alignedOffset = ((base + arena.Offset + alignment - 1) & ~(alignment - 1)) - base;
+
+                if (alignedOffset + size <= block.Size)
+                {
+                    arena.Offset = alignedOffset + size;
+                    arena.UsedBytes += size;
+
+                    return block.Memory.get() + alignedOffset;
+                }
+
+                // Rest of the block is wasted until the next reset
+                arena.CurrentBlock++;
+                arena.Offset = 0;
+            }
+
+            // Only happens while the arena is still warming up or the frame needs more than ever before
+            size_t blockSize = glm::max(m_BlockSize, size + alignment);
+            arena.Blocks.push_back({ CreateUnique<std::byte[]>(blockSize), blockSize });
+            THAT_CORE_INFO("Frame Allocator: Added {:.2f} MB block to arena", static_cast<float>(blockSize) / SIZE_MB(1));
+
+            return AllocateFromArena(arena, size, alignment);
+        }
+
+        private:
+        std::vector<Arena> m_Arenas;
+        std::mutex m_SharedArenaMutex;
+        FrameMemoryResource m_Resource;
+        size_t m_BlockSize = DEFAULT_BLOCK_SIZE;
+        size_t m_LastFrameUsedBytes = 0;
+    };
+
+    inline void* FrameMemoryResource::do_allocate(size_t size, size_t alignment)
+    {
+        return FrameAllocator::Get().Allocate(size, alignment);
+    }
+}
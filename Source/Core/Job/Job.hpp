@@ -0,0 +1,55 @@
+//
+// File: Job.hpp
+// Description: Fixed-size job slot that stores its callable inline and the counter used to wait on jobs
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+
+namespace ThatEngine
+{
+    struct JobCounter
+    {
+        std::atomic<uint32_t> Value = 0;
+
+        inline bool IsDone() const { return Value.load(std::memory_order_acquire) == 0; }
+    };
+
+    struct alignas(64) Job
+    {
+        static constexpr size_t STORAGE_SIZE = 40;
+
+        // Invokes the stored callable when asked to, then destroys it
+        using InvokeFunction = void(*)(Job&, bool shouldExecute);
+
+        InvokeFunction Invoke = nullptr;
+        JobCounter* Counter = nullptr;
+        std::atomic<bool> IsFree = true;
+        bool IsHeapAllocated = false;
+        alignas(8) std::byte Storage[STORAGE_SIZE];
+
+        template<typename Function>
+        void Store(Function&& function, JobCounter* counter)
+        {
+            using StoredFunction = std::decay_t<Function>;
+
+            static_assert(sizeof(StoredFunction) <= STORAGE_SIZE, "Job captures too much, capture by reference or pack the data into a struct!");
+            static_assert(alignof(StoredFunction) <= 8, "Job callable is over-aligned!");
+
+            new (Storage) StoredFunction(std::forward<Function>(function));
+            Counter = counter;
+            Invoke = [](Job& job, bool shouldExecute)
+            {
+                StoredFunction* stored = std::launder(reinterpret_cast<StoredFunction*>(job.Storage));
+                if (shouldExecute) (*stored)();
+                stored->~StoredFunction();
+            };
+        }
+    };
+
+    static_assert(sizeof(Job) == 64, "Job should fill exactly one cache line!");
+}
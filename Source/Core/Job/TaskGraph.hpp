@@ -0,0 +1,234 @@
+//
+// File: TaskGraph.hpp
+// Description: Graph of tasks with explicit predecessor edges, built once and executed on the
+//              JobManager as many times as needed, successors are released as soon as their
+//              last predecessor finishes
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+#include "Core/JobManager.hpp"
+
+namespace ThatEngine
+{
+    using TaskId = uint32_t;
+
+    enum class TaskAffinity
+    {
+        Any,
+        MainThread // Runs on the thread that calls Execute
+    };
+
+    class TaskGraph
+    {
+        public:
+        TaskGraph() = default;
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        TaskId AddTask(const std::string& name, std::function<void()> function, TaskAffinity affinity = TaskAffinity::Any)
+        {
+            THAT_CORE_ASSERT(!m_IsBuilt, "Task Graph: Cannot add task '{}' after the graph was built!", name);
+
+            Task task = {};
+            task.Name = name;
+            task.Function = std::move(function);
+            task.Affinity = affinity;
+
+            m_Tasks.push_back(std::move(task));
+            return static_cast<TaskId>(m_Tasks.size() - 1);
+        }
+
+        // Successor will not start before predecessor is done
+        void AddDependency(TaskId predecessor, TaskId successor)
+        {
+            THAT_CORE_ASSERT(!m_IsBuilt, "Task Graph: Cannot add dependency after the graph was built!", 0);
+            THAT_CORE_ASSERT(predecessor < m_Tasks.size() && successor < m_Tasks.size() && predecessor != successor, "Task Graph: Invalid dependency {} -> {}!", predecessor, successor);
+
+            m_Tasks[predecessor].Successors.push_back(successor);
+            m_Tasks[successor].PredecessorCount++;
+        }
+
+        // Validates the graph and prepares everything Execute needs, so executing does not allocate
+        bool Build()
+        {
+            m_RootTasks.clear();
+            m_PendingPredecessors = CreateUnique<std::atomic<uint32_t>[]>(m_Tasks.size());
+            m_MainThreadReadyTasks.clear();
+            m_MainThreadReadyTasks.reserve(m_Tasks.size());
+
+            for (TaskId id = 0; id < m_Tasks.size(); id++)
+            {
+                if (m_Tasks[id].PredecessorCount == 0)
+                {
+                    m_RootTasks.push_back(id);
+                }
+            }
+
+            // Kahn's algorithm, every task has to be reachable in topological order or there is a cycle
+            std::vector<uint32_t> predecessorCounts(m_Tasks.size());
+            std::vector<TaskId> readyTasks = m_RootTasks;
+            uint32_t visitedCount = 0;
+
+            for (TaskId id = 0; id < m_Tasks.size(); id++)
+            {
+                predecessorCounts[id] = m_Tasks[id].PredecessorCount;
+            }
+
+            while (!readyTasks.empty())
+            {
+                TaskId id = readyTasks.back();
+                readyTasks.pop_back();
+                visitedCount++;
+
+                for (TaskId successor : m_Tasks[id].Successors)
+                {
+                    if (--predecessorCounts[successor] == 0)
+                    {
+                        readyTasks.push_back(successor);
+                    }
+                }
+            }
+
+            if (visitedCount != m_Tasks.size())
+            {
+                THAT_CORE_ERROR("Task Graph: Dependency cycle detected, {} of {} tasks can never run!", m_Tasks.size() - visitedCount, m_Tasks.size());
+                return false;
+            }
+
+            m_IsBuilt = true;
+            return true;
+        }
+
+        // Runs every task once and returns when all of them are done, calling thread helps with the work
+        void Execute(JobManager& jobs)
+        {
+            THAT_CORE_ASSERT(m_IsBuilt, "Task Graph: Graph has to be built before execution!", 0);
+
+            if (m_Tasks.empty()) return;
+
+            m_Jobs = &jobs;
+            m_RemainingTaskCount.store(static_cast<uint32_t>(m_Tasks.size()), std::memory_order_relaxed);
+
+            for (TaskId id = 0; id < m_Tasks.size(); id++)
+            {
+                m_PendingPredecessors[id].store(m_Tasks[id].PredecessorCount, std::memory_order_relaxed);
+            }
+
+            for (TaskId id : m_RootTasks)
+            {
+                Release(id);
+            }
+
+            while (m_RemainingTaskCount.load(std::memory_order_acquire) != 0)
+            {
+                TaskId mainThreadTask = PopMainThreadTask();
+                if (mainThreadTask != INVALID_UINT32_ID)
+                {
+                    RunTask(mainThreadTask);
+                    continue;
+                }
+
+                if (jobs.TryExecuteJob()) continue;
+
+                std::this_thread::yield();
+            }
+
+            // Jobs may still be on their way out of RunTask
+            jobs.Wait(m_JobCounter);
+        }
+
+        inline uint32_t GetTaskCount() const { return static_cast<uint32_t>(m_Tasks.size()); }
+        inline const std::string& GetTaskName(TaskId id) const { return m_Tasks[id].Name; }
+
+        private:
+        void Release(TaskId id)
+        {
+            if (m_Tasks[id].Affinity == TaskAffinity::MainThread)
+            {
+                std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+                m_MainThreadReadyTasks.push_back(id);
+                m_MainThreadReadyCount.fetch_add(1, std::memory_order_release);
+                return;
+            }
+
+            m_Jobs->Run([this, id]()
+            {
+                RunTask(id);
+            }, m_JobCounter);
+        }
+
+        void RunTask(TaskId id)
+        {
+            // Continue with one ready successor on this thread instead of going through the queues
+            while (id != INVALID_UINT32_ID)
+            {
+                Task& task = m_Tasks[id];
+
+                {
+                    ZoneTransientN(zone, task.Name.c_str(), true);
+                    task.Function();
+                }
+
+                TaskId continuation = INVALID_UINT32_ID;
+                for (TaskId successor : task.Successors)
+                {
+                    if (m_PendingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+
+                    if (continuation == INVALID_UINT32_ID && m_Tasks[successor].Affinity == TaskAffinity::Any)
+                    {
+                        continuation = successor;
+                        continue;
+                    }
+
+                    Release(successor);
+                }
+
+                m_RemainingTaskCount.fetch_sub(1, std::memory_order_acq_rel);
+                id = continuation;
+            }
+        }
+
+        TaskId PopMainThreadTask()
+        {
+            // Avoid taking the lock while spinning on an empty list
+            if (m_MainThreadReadyCount.load(std::memory_order_acquire) == 0) return INVALID_UINT32_ID;
+
+            std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+            if (m_MainThreadReadyTasks.empty()) return INVALID_UINT32_ID;
+
+            TaskId id = m_MainThreadReadyTasks.back();
+            m_MainThreadReadyTasks.pop_back();
+            m_MainThreadReadyCount.fetch_sub(1, std::memory_order_relaxed);
+
+            return id;
+        }
+
+        private:
+        struct Task
+        {
+            std::string Name;
+            std::function<void()> Function;
+            TaskAffinity Affinity;
+            std::vector<TaskId> Successors;
+            uint32_t PredecessorCount = 0;
+        };
+
+        std::vector<Task> m_Tasks;
+        std::vector<TaskId> m_RootTasks;
+        Unique<std::atomic<uint32_t>[]> m_PendingPredecessors;
+        bool m_IsBuilt = false;
+
+        JobManager* m_Jobs = nullptr;
+        JobCounter m_JobCounter;
+        std::atomic<uint32_t> m_RemainingTaskCount = 0;
+
+        std::vector<TaskId> m_MainThreadReadyTasks;
+        std::atomic<uint32_t> m_MainThreadReadyCount = 0;
+        std::mutex m_MainThreadMutex;
+    };
+}
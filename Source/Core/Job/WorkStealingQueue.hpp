@@ -0,0 +1,105 @@
+//
+// File: WorkStealingQueue.hpp
+// Description: Fixed-capacity lock-free Chase-Lev deque, owner thread pushes and pops
+//              from the bottom while other threads steal from the top
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+
+namespace ThatEngine
+{
+    template<typename T, uint32_t Capacity>
+    class WorkStealingQueue
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Work stealing queue capacity must be a power of two!");
+
+        public:
+        WorkStealingQueue() = default;
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+        // Owner thread only
+        bool Push(T* item)
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t top = m_Top.load(std::memory_order_acquire);
+
+            if (bottom - top >= static_cast<int64_t>(Capacity)) return false;
+
+            m_Items[bottom & MASK].store(item, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        // Owner thread only
+        T* Pop()
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            // Queue was empty
+            if (top > bottom)
+            {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = m_Items[bottom & MASK].load(std::memory_order_relaxed);
+
+            // Last item, race against thieves
+            if (top == bottom)
+            {
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        // Any thread
+        T* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) return nullptr;
+
+            T* item = m_Items[top & MASK].load(std::memory_order_relaxed);
+
+            // Another thief or the owner got there first
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+        inline bool IsEmpty() const
+        {
+            return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+        }
+
+        private:
+        static constexpr int64_t MASK = static_cast<int64_t>(Capacity) - 1;
+
+        // Keep thieves and the owner on separate cache lines
+        alignas(64) std::atomic<int64_t> m_Top = 0;
+        alignas(64) std::atomic<int64_t> m_Bottom = 0;
+        alignas(64) std::atomic<T*> m_Items[Capacity] = {};
+    };
+}
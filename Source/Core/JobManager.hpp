@@ -1,6 +1,6 @@
 //
 // File: JobManager.hpp
-// Description: Manages a thread pool that executes submitted jobs asynchronously
+// Description: Manages a work-stealing thread pool that executes submitted jobs asynchronously
 //
 // Copyright (c) 2025 Sneshu
 // All rights reserved.
@@ -10,56 +10,105 @@
 
 #pragma once
 
+#include "Core/Job/Job.hpp"
+#include "Core/Job/WorkStealingQueue.hpp"
+#include "Core/MemoryTracker.hpp"
+
 namespace ThatEngine
 {
     class JobManager
     {
+        public:
+        static constexpr uint32_t JOB_QUEUE_CAPACITY = 4096;
+        static constexpr uint32_t JOB_POOL_SIZE = JOB_QUEUE_CAPACITY;
+        static constexpr uint32_t SPIN_COUNT_BEFORE_SLEEP = 64;
+        static constexpr uint32_t MIN_AUTO_GRAIN_SIZE = 64;
+        static constexpr uint32_t AUTO_GRAIN_CHUNKS_PER_THREAD = 4;
+
+        using JobQueue = WorkStealingQueue<Job, JOB_QUEUE_CAPACITY>;
+
+        // Ring of preallocated jobs, only the owning thread allocates from it
+        struct JobPool
+        {
+            std::array<Job, JOB_POOL_SIZE> Jobs;
+            uint32_t NextIndex = 0;
+        };
+
         public:
         JobManager() = default;
         ~JobManager() = default;
 
         void Init()
         {
-            m_ThreadCount = std::thread::hardware_concurrency();
-            THAT_CORE_INFO("Job Manager: {} threads are available!", m_ThreadCount);
+            // Calling thread helps out while waiting, so leave a core for it
+            m_ThreadCount = glm::max(std::thread::hardware_concurrency(), 2u) - 1;
+            THAT_CORE_INFO("Job Manager: {} worker threads are available!", m_ThreadCount);
 
+            // One deque and job pool per worker plus one for the thread that owns the manager
+            m_Queues.clear();
+            m_Pools.clear();
+            for (uint32_t i = 0; i < m_ThreadCount + 1; i++)
+            {
+                m_Queues.emplace_back(CreateUnique<JobQueue>());
+                m_Pools.emplace_back(CreateUnique<JobPool>());
+            }
+
+            s_ThreadIndex = m_ThreadCount;
             m_Running = true;
 
             for (uint32_t i = 0; i < m_ThreadCount; i++)
             {
-                m_Threads.emplace_back([&]()
+                m_Threads.emplace_back([this, i]()
                 {
-                    WorkerThread();
+                    WorkerThread(i);
                 });
             }
         }
-        
+
         void Shutdown()
         {
             m_Running = false;
-            m_Condition.notify_all();
+            m_WakeSignal.fetch_add(1);
+            m_WakeSignal.notify_all();
 
             for (auto& thread : m_Threads)
             {
                 if (!thread.joinable()) continue;
-                
+
                 thread.join();
             }
 
             m_Threads.clear();
 
+            // Drop jobs that never got to run
+            for (auto& queue : m_Queues)
+            {
+                while (Job* job = queue->Steal())
+                {
+                    Discard(job);
+                }
+            }
+
             // Lock queue for safety
             {
-                std::lock_guard<std::mutex> lock(m_QueueMutex);
-                while(!m_JobQueue.empty())
+                std::lock_guard<std::mutex> lock(m_InjectionMutex);
+                while(!m_InjectionQueue.empty())
                 {
-                    m_JobQueue.pop();
+                    Discard(m_InjectionQueue.front());
+                    m_InjectionQueue.pop();
                 }
+
+                m_InjectedJobCount = 0;
             }
+
+            s_ThreadIndex = INVALID_UINT32_ID;
         }
 
         inline uint32_t GetThreadCount() const { return m_ThreadCount; }
 
+        // Worker threads are [0, ThreadCount), owning thread is ThreadCount, anything else is INVALID_UINT32_ID
+        static inline uint32_t GetCurrentThreadIndex() { return s_ThreadIndex; }
+
         template<typename Function>
         auto Submit(Function&& task) -> std::future<decltype(task())>
         {
@@ -68,48 +117,325 @@ namespace ThatEngine
             auto packagedTask = CreateShared<std::packaged_task<ReturnType()>>(std::forward<Function>(task));
             std::future<ReturnType> future = packagedTask->get_future();
 
-            auto job = [packagedTask]() { (*packagedTask)(); };
+            Dispatch([packagedTask]() { (*packagedTask)(); }, nullptr);
 
-            // Lock queue for safety
+            return future;
+        }
+
+        // Allocation-free path, function is stored inline in a pooled job and completion is
+        // signalled through counter. Wait on the counter before anything the job captures goes away.
+        template<typename Function>
+        void Run(Function&& function, JobCounter& counter)
+        {
+            Dispatch(std::forward<Function>(function), &counter);
+        }
+
+        // Calls function(rangeBegin, rangeEnd) over [begin, end), splitting recursively down to grainSize.
+        // Calling thread takes part and the call returns once the whole range is processed.
+        // A grainSize of 0 picks one based on the range size and thread count.
+        template<typename Function>
+        void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, Function&& function)
+        {
+            if (begin >= end) return;
+
+            const uint32_t count = end - begin;
+            if (grainSize == 0)
             {
-                std::lock_guard<std::mutex> lock(m_QueueMutex);
-                m_JobQueue.emplace(std::move(job));
+                grainSize = glm::max(count / ((m_ThreadCount + 1) * AUTO_GRAIN_CHUNKS_PER_THREAD), MIN_AUTO_GRAIN_SIZE);
             }
 
-            m_Condition.notify_one();
+            // Not worth the scheduling overhead
+            if (count <= grainSize || m_Threads.empty())
+            {
+                function(begin, end);
+                return;
+            }
 
-            return future;
+            // Calling thread works on the first chunk, counter only tracks the handed out ones
+            JobCounter counter;
+            ParallelForRange(begin, end, grainSize, function, counter);
+
+            Wait(counter);
+        }
+
+        // Calls function(entity) for every entity of an EnTT view, see ParallelFor
+        template<typename View, typename Function>
+        void ParallelForEach(const View& view, uint32_t grainSize, Function&& function)
+        {
+            // Walk the leading storage directly, no need to copy the entities out
+            const auto* storage = view.handle();
+            if (!storage) return;
+
+            const auto* entities = storage->data();
+
+            ParallelFor(0, static_cast<uint32_t>(storage->size()), grainSize, [&](uint32_t rangeBegin, uint32_t rangeEnd)
+            {
+                for (uint32_t i = rangeBegin; i < rangeEnd; i++)
+                {
+                    const auto entity = entities[i];
+                    if (!view.contains(entity)) continue;
+
+                    function(entity);
+                }
+            });
+        }
+
+        // Blocks until counter reaches zero, executing other jobs in the meantime
+        void Wait(const JobCounter& counter)
+        {
+            while (!counter.IsDone())
+            {
+                if (TryExecuteJob()) continue;
+
+                std::this_thread::yield();
+            }
+        }
+
+        // Runs one queued job on the calling thread, returns false if there was nothing to run
+        bool TryExecuteJob()
+        {
+            Job* job = FindJob(s_ThreadIndex, s_RandomState);
+            if (!job) return false;
+
+            Execute(job);
+            return true;
+        }
+
+        private:
+        template<typename Function>
+        void ParallelForRange(uint32_t begin, uint32_t end, uint32_t grainSize, Function& function, JobCounter& counter)
+        {
+            // Hand the upper halves out to thieves and keep splitting the lower one
+            while (end - begin > grainSize)
+            {
+                uint32_t middle = begin + (end - begin) / 2;
+
+                Dispatch([this, middle, end, grainSize, &function, &counter]()
+                {
+                    ParallelForRange(middle, end, grainSize, function, counter);
+                }, &counter);
+
+                end = middle;
+            }
+
+            function(begin, end);
         }
 
         private:
-        void WorkerThread()
+        template<typename Function>
+        void Dispatch(Function&& function, JobCounter* counter)
         {
+            if (counter)
+            {
+                counter->Value.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            Job* job = AllocateJob();
+
+            // Ring wrapped around onto a job that is still in flight
+            if (!job)
+            {
+                function();
+                if (counter) counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+                return;
+            }
+
+            job->Store(std::forward<Function>(function), counter);
+            Push(job);
+        }
+
+        Job* AllocateJob()
+        {
+            uint32_t threadIndex = s_ThreadIndex;
+
+            // Threads outside of the pool have no ring of their own, they are off the hot path anyway
+            if (threadIndex >= m_Pools.size())
+            {
+                Job* job = new Job();
+                job->IsFree.store(false, std::memory_order_relaxed);
+                job->IsHeapAllocated = true;
+
+                return job;
+            }
+
+            JobPool& pool = *m_Pools[threadIndex];
+            Job& job = pool.Jobs[pool.NextIndex++ & (JOB_POOL_SIZE - 1)];
+
+            if (!job.IsFree.load(std::memory_order_acquire)) return nullptr;
+
+            job.IsFree.store(false, std::memory_order_relaxed);
+            return &job;
+        }
+
+        void ReleaseJob(Job* job)
+        {
+            if (job->IsHeapAllocated)
+            {
+                delete job;
+                return;
+            }
+
+            job->IsFree.store(true, std::memory_order_release);
+        }
+
+        void Push(Job* job)
+        {
+            uint32_t threadIndex = s_ThreadIndex;
+
+            if (threadIndex < m_Queues.size())
+            {
+                // Own deque is full, running inline is cheaper than waiting for room
+                if (!m_Queues[threadIndex]->Push(job))
+                {
+                    Execute(job);
+                    return;
+                }
+            }
+            else
+            {
+                // Threads outside of the pool hand jobs over through a locked queue
+                std::lock_guard<std::mutex> lock(m_InjectionMutex);
+                m_InjectionQueue.push(job);
+                m_InjectedJobCount.fetch_add(1);
+            }
+
+            WakeWorker();
+        }
+
+        void WakeWorker()
+        {
+            m_WakeSignal.fetch_add(1);
+
+            // Skip the syscall when everybody is already awake
+            if (m_SleepingThreadCount.load() > 0)
+            {
+                m_WakeSignal.notify_one();
+            }
+        }
+
+        Job* FindJob(uint32_t threadIndex, uint32_t& randomState)
+        {
+            // Own deque first, newest job is the one most likely still in cache
+            if (threadIndex < m_Queues.size())
+            {
+                if (Job* job = m_Queues[threadIndex]->Pop())
+                {
+                    return job;
+                }
+            }
+
+            // Steal from random victims, oldest job first
+            uint32_t queueCount = static_cast<uint32_t>(m_Queues.size());
+            for (uint32_t attempt = 0; attempt < queueCount; attempt++)
+            {
+                randomState ^= randomState << 13;
+                randomState ^= randomState >> 17;
+                randomState ^= randomState << 5;
+
+                uint32_t victim = randomState % queueCount;
+                if (victim == threadIndex) continue;
+
+                if (Job* job = m_Queues[victim]->Steal())
+                {
+                    return job;
+                }
+            }
+
+            if (m_InjectedJobCount.load(std::memory_order_relaxed) > 0)
+            {
+                std::lock_guard<std::mutex> lock(m_InjectionMutex);
+                if (!m_InjectionQueue.empty())
+                {
+                    Job* job = m_InjectionQueue.front();
+                    m_InjectionQueue.pop();
+                    m_InjectedJobCount.fetch_sub(1);
+
+                    return job;
+                }
+            }
+
+            return nullptr;
+        }
+
+        inline void Execute(Job* job)
+        {
+            JobCounter* counter = job->Counter;
+
+            job->Invoke(*job, true);
+            ReleaseJob(job);
+
+            if (counter)
+            {
+                counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        inline void Discard(Job* job)
+        {
+            job->Invoke(*job, false);
+            ReleaseJob(job);
+        }
+
+        void WorkerThread(uint32_t threadIndex)
+        {
+            s_ThreadIndex = threadIndex;
+            s_RandomState = 0x9E3779B9u ^ (threadIndex + 1) * 0x85EBCA6Bu;
+            ScopedAllocationTag allocationTag(AllocationTag::Jobs);
+            uint32_t idleSpins = 0;
+
             while(m_Running)
             {
-                std::function<void()> job;
+                if (Job* job = FindJob(threadIndex, s_RandomState))
+                {
+                    Execute(job);
+                    idleSpins = 0;
+                    continue;
+                }
 
-                // Lock queue for safety
+                if (idleSpins++ < SPIN_COUNT_BEFORE_SLEEP)
                 {
-                    std::unique_lock<std::mutex> lock(m_QueueMutex);
-                    m_Condition.wait(lock, [&]() { return !m_Running || !m_JobQueue.empty(); });
+                    std::this_thread::yield();
+                    continue;
+                }
 
-                    if (!m_Running && m_JobQueue.empty()) return;
+                // Announce sleep before the final check so a concurrent push cannot be missed
+                m_SleepingThreadCount.fetch_add(1);
+                uint32_t signal = m_WakeSignal.load();
 
-                    job = std::move(m_JobQueue.front());
-                    m_JobQueue.pop();
+                if (Job* job = FindJob(threadIndex, s_RandomState))
+                {
+                    m_SleepingThreadCount.fetch_sub(1);
+                    Execute(job);
+                    idleSpins = 0;
+                    continue;
+                }
+
+                if (m_Running)
+                {
+                    m_WakeSignal.wait(signal);
                 }
 
-                job();
+                m_SleepingThreadCount.fetch_sub(1);
+                idleSpins = 0;
             }
         }
 
         private:
         uint32_t m_ThreadCount;
-        
-        std::queue<std::function<void()>> m_JobQueue;
+
+        std::vector<Unique<JobQueue>> m_Queues;
+        std::vector<Unique<JobPool>> m_Pools;
         std::vector<std::thread> m_Threads;
-        std::condition_variable m_Condition;
-        std::mutex m_QueueMutex;
+
+        std::queue<Job*> m_InjectionQueue;
+        std::mutex m_InjectionMutex;
+        std::atomic<uint32_t> m_InjectedJobCount = 0;
+
+        std::atomic<uint32_t> m_WakeSignal = 0;
+        std::atomic<uint32_t> m_SleepingThreadCount = 0;
         std::atomic<bool> m_Running;
+
+        static inline thread_local uint32_t s_ThreadIndex = INVALID_UINT32_ID;
+        static inline thread_local uint32_t s_RandomState = 0x2545F491u;
     };
-}
\ No newline at end of file
+}
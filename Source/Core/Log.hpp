@@ -13,6 +13,7 @@
 #include "Core/Pattern/Singleton.hpp"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <iomanip>
 
 namespace ThatEngine
@@ -30,7 +31,7 @@ namespace ThatEngine
             timeStream << std::put_time(&localTime, "%Y-%m-%d_%H-%M-%S");
         
             const std::string outputPattern = "[%T] [%n] [%^%l%$] %v";
-            auto consoleSink = CreateShared<spdlog::sinks::wincolor_stdout_sink_mt>();
+            auto consoleSink = CreateShared<spdlog::sinks::stdout_color_sink_mt>();
             consoleSink->set_pattern(outputPattern);
             
             const std::string fileName = "./Logs/" + timeStream.str() + ".log";
@@ -76,7 +77,7 @@ namespace ThatEngine
         if (!(x))                                   \
         {                                           \
             THAT_CORE_ERROR(message, __VA_ARGS__);  \
-            __debugbreak();                         \
+            DEBUG_BREAK();                          \
         }                                           \
     }
     #else
@@ -0,0 +1,98 @@
+//
+// File: MemoryTracker.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Core/MemoryTracker.hpp"
+
+#ifdef ALLOCATION_TRACKING
+
+#include <cstdlib>
+#include <new>
+
+#ifndef PLATFORM_WINDOWS
+#include <malloc.h>
+#endif
+
+// Sizes come from the heap itself, so deletes without a size are counted correctly and no header is needed
+namespace
+{
+    inline size_t GetAllocationSize(void* pointer)
+    {
+        #ifdef PLATFORM_WINDOWS
+        return _msize(pointer);
+        #else
+        return malloc_usable_size(pointer);
+        #endif
+    }
+
+    inline size_t GetAlignedAllocationSize(void* pointer, std::align_val_t alignment)
+    {
+        #ifdef PLATFORM_WINDOWS
+        return _aligned_msize(pointer, static_cast<size_t>(alignment), 0);
+        #else
+        return malloc_usable_size(pointer);
+        #endif
+    }
+}
+
+// Replacing the plain and aligned forms is enough, every other operator new forwards to them
+void* operator new(size_t size)
+{
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+
+    ThatEngine::MemoryTracker::RecordAllocation(GetAllocationSize(pointer));
+    return pointer;
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    #ifdef PLATFORM_WINDOWS
+    void* pointer = _aligned_malloc(size ? size : 1, static_cast<size_t>(alignment));
+    #else
+    size_t alignedSize = ((size ? size : 1) + static_cast<size_t>(alignment) - 1) & ~(static_cast<size_t>(alignment) - 1);
+    void* pointer = std::aligned_alloc(static_cast<size_t>(alignment), alignedSize);
+    #endif
+
+    if (!pointer) throw std::bad_alloc();
+
+    ThatEngine::MemoryTracker::RecordAllocation(GetAlignedAllocationSize(pointer, alignment));
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer) return;
+
+    ThatEngine::MemoryTracker::RecordDeallocation(GetAllocationSize(pointer));
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    if (!pointer) return;
+
+    ThatEngine::MemoryTracker::RecordDeallocation(GetAlignedAllocationSize(pointer, alignment));
+
+    #ifdef PLATFORM_WINDOWS
+    _aligned_free(pointer);
+    #else
+    std::free(pointer);
+    #endif
+}
+
+void operator delete(void* pointer, size_t size, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+#endif
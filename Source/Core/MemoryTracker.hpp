@@ -0,0 +1,134 @@
+//
+// File: MemoryTracker.hpp
+// Description: Counts global heap allocations and bytes per frame and per tag when built with
+//              ALLOCATION_TRACKING, used to catch allocation storms and memory growth
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+namespace ThatEngine
+{
+    // Attributed to the thread's current tag, see ScopedAllocationTag
+    enum class AllocationTag : uint8_t
+    {
+        General,
+        ECS,
+        Renderer,
+        Font,
+        Jobs,
+        Count
+    };
+
+    inline const char* ToString(AllocationTag tag)
+    {
+        switch (tag)
+        {
+            case AllocationTag::General:  return "General";
+            case AllocationTag::ECS:      return "ECS";
+            case AllocationTag::Renderer: return "Renderer";
+            case AllocationTag::Font:     return "Font";
+            case AllocationTag::Jobs:     return "Jobs";
+            default:                      return "Unknown";
+        }
+    }
+
+    struct AllocationStats
+    {
+        uint64_t AllocationCount = 0;
+        uint64_t ByteCount = 0;
+    };
+
+    class MemoryTracker
+    {
+        public:
+        static constexpr uint32_t TAG_COUNT = static_cast<uint32_t>(AllocationTag::Count);
+
+        public:
+        // Called by the global operator new and delete replacements
+        static inline void RecordAllocation(size_t size)
+        {
+            TagCounters& counters = s_Counters[static_cast<uint32_t>(s_CurrentTag)];
+            counters.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+            counters.ByteCount.fetch_add(size, std::memory_order_relaxed);
+            s_LiveByteCount.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+
+        static inline void RecordDeallocation(size_t size)
+        {
+            s_LiveByteCount.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+
+        static inline AllocationTag GetCurrentTag() { return s_CurrentTag; }
+        static inline void SetCurrentTag(AllocationTag tag) { s_CurrentTag = tag; }
+
+        // Closes the current frame, frame stats are the difference to the previous call
+        static void EndFrame()
+        {
+            s_FrameTotalStats = {};
+
+            for (uint32_t i = 0; i < TAG_COUNT; i++)
+            {
+                AllocationStats total = GetTotalStats(static_cast<AllocationTag>(i));
+
+                s_FrameStats[i].AllocationCount = total.AllocationCount - s_PreviousTotalStats[i].AllocationCount;
+                s_FrameStats[i].ByteCount = total.ByteCount - s_PreviousTotalStats[i].ByteCount;
+                s_PreviousTotalStats[i] = total;
+
+                s_FrameTotalStats.AllocationCount += s_FrameStats[i].AllocationCount;
+                s_FrameTotalStats.ByteCount += s_FrameStats[i].ByteCount;
+            }
+        }
+
+        // Since startup
+        static inline AllocationStats GetTotalStats(AllocationTag tag)
+        {
+            const TagCounters& counters = s_Counters[static_cast<uint32_t>(tag)];
+            return { counters.AllocationCount.load(std::memory_order_relaxed), counters.ByteCount.load(std::memory_order_relaxed) };
+        }
+
+        // Last frame closed by EndFrame
+        static inline const AllocationStats& GetFrameStats(AllocationTag tag) { return s_FrameStats[static_cast<uint32_t>(tag)]; }
+        static inline const AllocationStats& GetFrameStats() { return s_FrameTotalStats; }
+
+        // Bytes currently allocated through the global heap, keeps growing if something leaks
+        static inline int64_t GetLiveByteCount() { return s_LiveByteCount.load(std::memory_order_relaxed); }
+
+        private:
+        // Atomics start at zero
+        struct alignas(64) TagCounters
+        {
+            std::atomic<uint64_t> AllocationCount;
+            std::atomic<uint64_t> ByteCount;
+        };
+
+        static inline std::array<TagCounters, TAG_COUNT> s_Counters;
+        static inline std::atomic<int64_t> s_LiveByteCount = 0;
+        static inline thread_local AllocationTag s_CurrentTag = AllocationTag::General;
+
+        // Only touched by the thread calling EndFrame
+        static inline std::array<AllocationStats, TAG_COUNT> s_PreviousTotalStats = {};
+        static inline std::array<AllocationStats, TAG_COUNT> s_FrameStats = {};
+        static inline AllocationStats s_FrameTotalStats = {};
+    };
+
+    // Attributes allocations made by this thread to the tag until the end of the scope
+    class ScopedAllocationTag
+    {
+        public:
+        ScopedAllocationTag(AllocationTag tag) : m_PreviousTag(MemoryTracker::GetCurrentTag()) { MemoryTracker::SetCurrentTag(tag); }
+        ~ScopedAllocationTag() { MemoryTracker::SetCurrentTag(m_PreviousTag); }
+
+        ScopedAllocationTag(const ScopedAllocationTag&) = delete;
+        ScopedAllocationTag& operator=(const ScopedAllocationTag&) = delete;
+
+        private:
+        AllocationTag m_PreviousTag;
+    };
+}
@@ -0,0 +1,142 @@
+//
+// File: RollingStatistics.hpp
+// Description: Keeps the last N samples of a value and computes min, average, max and percentiles over them,
+//              shared nearest-rank percentile and summary helpers for any set of samples
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+
+#include <algorithm>
+#include <span>
+
+namespace ThatEngine
+{
+    struct SampleSummary
+    {
+        uint32_t SampleCount;
+        float Average;
+        float Min;
+        float P50;
+        float P95;
+        float P99;
+        float Max;
+    };
+
+    // Index of the nearest-rank percentile in sampleCount sorted samples, percentile is in [0, 1]
+    inline uint32_t GetPercentileIndex(uint32_t sampleCount, float percentile)
+    {
+        uint32_t rank = static_cast<uint32_t>(glm::ceil(glm::clamp(percentile, 0.0f, 1.0f) * sampleCount));
+        return glm::max(rank, 1u) - 1;
+    }
+
+    inline float GetPercentile(std::span<const float> sortedSamples, float percentile)
+    {
+        if (sortedSamples.empty()) return 0.0f;
+
+        return sortedSamples[GetPercentileIndex(static_cast<uint32_t>(sortedSamples.size()), percentile)];
+    }
+
+    // Sorts the samples in place
+    inline SampleSummary SummarizeSamples(std::span<float> samples)
+    {
+        SampleSummary summary = {};
+        if (samples.empty()) return summary;
+
+        double sum = 0.0;
+        for (float sample : samples)
+        {
+            sum += sample;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        summary.SampleCount = static_cast<uint32_t>(samples.size());
+        summary.Average = static_cast<float>(sum / samples.size());
+        summary.Min = samples.front();
+        summary.P50 = GetPercentile(samples, 0.50f);
+        summary.P95 = GetPercentile(samples, 0.95f);
+        summary.P99 = GetPercentile(samples, 0.99f);
+        summary.Max = samples.back();
+
+        return summary;
+    }
+
+    template<uint32_t WindowSize>
+    class RollingStatistics
+    {
+        static_assert(WindowSize > 0, "Rolling statistics window cannot be empty!");
+
+        public:
+        RollingStatistics() = default;
+
+        void AddSample(float value)
+        {
+            if (m_SampleCount == WindowSize)
+            {
+                m_Sum -= m_Samples[m_NextIndex];
+            }
+
+            else
+            {
+                m_SampleCount++;
+            }
+
+            m_Samples[m_NextIndex] = value;
+            m_Sum += value;
+            m_LastSample = value;
+            m_NextIndex = (m_NextIndex + 1) % WindowSize;
+        }
+
+        void Reset()
+        {
+            m_SampleCount = 0;
+            m_NextIndex = 0;
+            m_Sum = 0.0;
+            m_LastSample = 0.0f;
+        }
+
+        inline uint32_t GetSampleCount() const { return m_SampleCount; }
+        inline float GetLast() const { return m_LastSample; }
+        inline float GetAverage() const { return m_SampleCount ? static_cast<float>(m_Sum / m_SampleCount) : 0.0f; }
+
+        float GetMin() const
+        {
+            if (m_SampleCount == 0) return 0.0f;
+
+            return *std::min_element(m_Samples.begin(), m_Samples.begin() + m_SampleCount);
+        }
+
+        float GetMax() const
+        {
+            if (m_SampleCount == 0) return 0.0f;
+
+            return *std::max_element(m_Samples.begin(), m_Samples.begin() + m_SampleCount);
+        }
+
+        // Nearest-rank percentile, percentile is in [0, 1], only partially sorts a copy of the window
+        float GetPercentile(float percentile) const
+        {
+            if (m_SampleCount == 0) return 0.0f;
+
+            std::array<float, WindowSize> sorted;
+            std::copy(m_Samples.begin(), m_Samples.begin() + m_SampleCount, sorted.begin());
+
+            uint32_t index = GetPercentileIndex(m_SampleCount, percentile);
+            std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + m_SampleCount);
+
+            return sorted[index];
+        }
+
+        private:
+        std::array<float, WindowSize> m_Samples = {};
+        uint32_t m_SampleCount = 0;
+        uint32_t m_NextIndex = 0;
+        double m_Sum = 0.0;
+        float m_LastSample = 0.0f;
+    };
+}
@@ -0,0 +1,172 @@
+//
+// File: StatsTracker.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Core/StatsTracker.hpp"
+
+namespace ThatEngine
+{
+    StatsTracker::StatsTracker()
+    {
+        m_CpuTimeCounter = RegisterCounter("CPU Time");
+        m_GpuTimeCounter = RegisterCounter("GPU Time");
+        m_FrameTimeCounter = RegisterCounter("Frame Time");
+        m_RamUsageCounter = RegisterCounter("RAM Usage");
+    }
+
+    void StatsTracker::SetProcessMemory(const Utils::Memory::ProcessMemoryInfo& info)
+    {
+        m_ProcessMemory = info;
+        m_Counters[m_RamUsageCounter]->AddSample(info.Resident);
+    }
+
+    void StatsTracker::SetGpuRegionTimes(const std::vector<GpuRegionTime>& times)
+    {
+        m_GpuRegionTimes.assign(times.begin(), times.end());
+
+        for (const GpuRegionTime& region : times)
+        {
+            auto iterator = std::find_if(m_GpuRegionCounters.begin(), m_GpuRegionCounters.end(), [&region](const auto& entry) { return entry.first == region.Name; });
+            if (iterator == m_GpuRegionCounters.end())
+            {
+                CounterId counter = RegisterCounter(std::string("GPU ") + region.Name);
+                iterator = m_GpuRegionCounters.emplace(m_GpuRegionCounters.end(), region.Name, counter);
+            }
+
+            if (iterator->second != INVALID_UINT32_ID)
+            {
+                m_Counters[iterator->second]->AddSample(region.Time);
+            }
+        }
+    }
+
+    void StatsTracker::EndFrame(float frameTime)
+    {
+        m_Counters[m_FrameTimeCounter]->AddSample(frameTime);
+
+        const uint32_t bucket = glm::min(static_cast<uint32_t>(frameTime / HISTOGRAM_BUCKET_WIDTH), HISTOGRAM_BUCKET_COUNT - 1);
+        m_FrameTimeHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        // Median of the frames before this one, so a hitch does not raise its own threshold
+        if (m_HitchWindow.GetSampleCount() == HITCH_WINDOW_SIZE)
+        {
+            const float medianTime = m_HitchWindow.GetPercentile(0.5f);
+            if (frameTime > medianTime * m_HitchFactor)
+            {
+                const uint64_t hitchCount = m_HitchCount.load(std::memory_order_relaxed);
+                m_Hitches[hitchCount % MAX_RECORDED_HITCHES] = { m_FrameIndex, frameTime, medianTime };
+                m_HitchCount.store(hitchCount + 1, std::memory_order_release);
+
+                TracyMessageL("Hitch");
+
+                // Rate limited, loading screens and window drags hitch every frame
+                if (m_HitchWarningTimer.GetElapsedTime().GetSeconds() >= HITCH_WARNING_INTERVAL)
+                {
+                    THAT_CORE_WARN("Stats Tracker: Frame {} took {:.3f} ms, {:.1f}x the median of {:.3f} ms ({} hitches so far)",
+                        m_FrameIndex, frameTime, frameTime / medianTime, medianTime, hitchCount + 1);
+                    m_HitchWarningTimer.Reset();
+                }
+            }
+        }
+
+        m_HitchWindow.AddSample(frameTime);
+        m_FrameIndex++;
+    }
+
+    CounterId StatsTracker::RegisterCounter(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(m_RegisterMutex);
+
+        CounterId counter = FindCounter(name);
+        if (counter != INVALID_UINT32_ID) return counter;
+
+        counter = m_CounterCount.load(std::memory_order_relaxed);
+        if (counter == MAX_COUNTERS)
+        {
+            THAT_CORE_WARN("Stats Tracker: Cannot register counter '{}', all {} counters are taken!", name, MAX_COUNTERS);
+            return INVALID_UINT32_ID;
+        }
+
+        m_Counters[counter] = CreateUnique<CounterHistory>(name);
+        m_CounterCount.store(counter + 1, std::memory_order_release);
+
+        return counter;
+    }
+
+    CounterId StatsTracker::FindCounter(std::string_view name) const
+    {
+        const uint32_t counterCount = GetCounterCount();
+        for (CounterId counter = 0; counter < counterCount; counter++)
+        {
+            if (m_Counters[counter]->GetName() == name) return counter;
+        }
+
+        return INVALID_UINT32_ID;
+    }
+
+    bool StatsTracker::DumpToFile(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            THAT_CORE_ERROR("Stats Tracker: Failed to open \"{}\" for writing!", path);
+            return false;
+        }
+
+        std::array<float, CounterHistory::CAPACITY> samples;
+
+        file << "{\n";
+        file << "  \"frames\": " << m_Counters[m_FrameTimeCounter]->GetTotalSampleCount() << ",\n";
+        file << "  \"hitch_factor\": " << m_HitchFactor << ",\n";
+
+        // Counters
+        file << "  \"counters\": {";
+        const uint32_t counterCount = GetCounterCount();
+        for (CounterId counter = 0; counter < counterCount; counter++)
+        {
+            const CounterHistory& history = *m_Counters[counter];
+            const CounterSummary summary = history.GetSummary(CounterHistory::CAPACITY);
+
+            file << (counter == 0 ? "\n" : ",\n") << "    \"" << history.GetName() << "\": { ";
+            file << "\"avg\": " << summary.Average << ", \"min\": " << summary.Min << ", \"p50\": " << summary.P50
+                 << ", \"p95\": " << summary.P95 << ", \"p99\": " << summary.P99 << ", \"max\": " << summary.Max << ", \"samples\": [";
+
+            const uint32_t sampleCount = history.CopySamples(samples.data(), CounterHistory::CAPACITY);
+            for (uint32_t i = 0; i < sampleCount; i++)
+            {
+                file << (i == 0 ? "" : ", ") << samples[i];
+            }
+
+            file << "] }";
+        }
+        file << "\n  },\n";
+
+        // Histogram, bucket i counts frames in [i, i + 1) * HISTOGRAM_BUCKET_WIDTH
+        file << "  \"frame_time_histogram\": { \"bucket_width_ms\": " << HISTOGRAM_BUCKET_WIDTH << ", \"counts\": [";
+        for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; bucket++)
+        {
+            file << (bucket == 0 ? "" : ", ") << GetFrameTimeHistogramBucket(bucket);
+        }
+        file << "] },\n";
+
+        // Most recent hitches, oldest first
+        const uint64_t hitchCount = GetHitchCount();
+        const uint64_t firstHitch = hitchCount - glm::min<uint64_t>(hitchCount, MAX_RECORDED_HITCHES);
+
+        file << "  \"hitch_count\": " << hitchCount << ",\n";
+        file << "  \"hitches\": [";
+        for (uint64_t i = firstHitch; i < hitchCount; i++)
+        {
+            const FrameHitch& hitch = m_Hitches[i % MAX_RECORDED_HITCHES];
+            file << (i == firstHitch ? "\n" : ",\n") << "    { \"frame\": " << hitch.Frame << ", \"ms\": " << hitch.FrameTime << ", \"median_ms\": " << hitch.MedianTime << " }";
+        }
+        file << "\n  ]\n}\n";
+
+        THAT_CORE_INFO("Stats Tracker: Wrote {} counters and {} hitches to \"{}\"", counterCount, hitchCount, path);
+        return file.good();
+    }
+}
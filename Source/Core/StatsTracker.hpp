@@ -1,6 +1,7 @@
 //
 // File: StatsTracker.hpp
-// Description: Measures and tracks performance stats
+// Description: Measures and tracks performance stats, keeps a history of named counters,
+//              a frame time histogram and frames that hitched
 //
 // Copyright (c) 2025 Sneshu
 // All rights reserved.
@@ -9,28 +10,141 @@
 #pragma once
 
 #include "Core/Timer.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Core/CounterHistory.hpp"
+#include "Core/RollingStatistics.hpp"
+#include "Utils/MemoryUtils.hpp"
 
 namespace ThatEngine
 {
+    // GPU time of a named profiler region, regions nest, the frame itself is the only one at depth 0
+    struct GpuRegionTime
+    {
+        const char* Name;
+        uint32_t Depth;
+        float Time; // ms
+    };
+
+    // Counted over the whole frame, only filled when pipeline statistics are collected
+    struct GpuPipelineStatistics
+    {
+        uint64_t InputAssemblyVertices;
+        uint64_t InputAssemblyPrimitives;
+        uint64_t VertexShaderInvocations;
+        uint64_t ClippingPrimitives;
+        uint64_t FragmentShaderInvocations;
+        uint64_t ComputeShaderInvocations;
+    };
+
+    // Frame that took longer than the hitch factor times the median of the frames before it
+    struct FrameHitch
+    {
+        uint64_t Frame;
+        float FrameTime;    // ms
+        float MedianTime;   // ms
+    };
+
     class StatsTracker
     {
         public:
-        StatsTracker() = default;
-        
-        inline constexpr float GetCpuTime() const { return m_CpuTime; }
-        inline constexpr float GetGpuTime() const { return m_GpuTime; }
-        inline constexpr float GetRamUsage() const { return m_RamUsage; }
+        static constexpr uint32_t MAX_COUNTERS = 64;
+
+        static constexpr uint32_t HISTOGRAM_BUCKET_COUNT = 64;
+        static constexpr float HISTOGRAM_BUCKET_WIDTH = 1.0f; // ms, the last bucket also counts every longer frame
+
+        static constexpr uint32_t HITCH_WINDOW_SIZE = 120;
+        static constexpr float DEFAULT_HITCH_FACTOR = 2.0f;
+        static constexpr uint32_t MAX_RECORDED_HITCHES = 256;
+        static constexpr float HITCH_WARNING_INTERVAL = 1.0f; // seconds
+
+        static constexpr const char* DEFAULT_DUMP_PATH = "Stats.json";
+
+        public:
+        StatsTracker();
+
+        StatsTracker(const StatsTracker&) = delete;
+        StatsTracker& operator=(const StatsTracker&) = delete;
+
+        inline float GetCpuTime() const { return m_Counters[m_CpuTimeCounter]->GetLast(); }
+        inline float GetGpuTime() const { return m_Counters[m_GpuTimeCounter]->GetLast(); }
+        inline constexpr float GetRamUsage() const { return m_ProcessMemory.Resident; }
+        inline constexpr const Utils::Memory::ProcessMemoryInfo& GetProcessMemory() const { return m_ProcessMemory; }
+        inline constexpr const AllocationStats& GetFrameAllocationStats() const { return m_FrameAllocationStats; }
+        inline const std::vector<GpuRegionTime>& GetGpuRegionTimes() const { return m_GpuRegionTimes; }
+        inline constexpr const GpuPipelineStatistics& GetGpuPipelineStatistics() const { return m_GpuPipelineStatistics; }
 
         inline void StartCpuMeasurement() { m_CpuTimer.Reset(); }
-        inline void StopCpuMeasurement() { m_CpuTime = m_CpuTimer.GetElapsedTime().GetMilliseconds(); }
-        inline void SetGpuTime (float milliseconds) { m_GpuTime = milliseconds; }
-        inline void SetRamUsage(float usage) { m_RamUsage = usage; }  
+        inline void StopCpuMeasurement() { m_Counters[m_CpuTimeCounter]->AddSample(m_CpuTimer.GetElapsedTime().GetMilliseconds()); }
+        inline void SetGpuTime (float milliseconds) { m_Counters[m_GpuTimeCounter]->AddSample(milliseconds); }
+        void SetProcessMemory(const Utils::Memory::ProcessMemoryInfo& info);
+        inline void SetFrameAllocationStats(const AllocationStats& stats) { m_FrameAllocationStats = stats; }
+        void SetGpuRegionTimes(const std::vector<GpuRegionTime>& times);
+        inline void SetGpuPipelineStatistics(const GpuPipelineStatistics& statistics) { m_GpuPipelineStatistics = statistics; }
+
+        // Measured wall time of the whole frame, feeds the frame time counter, histogram and hitch detection
+        void EndFrame(float frameTime);
+
+        // Returns the existing counter if one with the same name is registered, INVALID_UINT32_ID once all are taken
+        CounterId RegisterCounter(std::string_view name);
+        CounterId FindCounter(std::string_view name) const;
+
+        // Lock-free, each counter may only be written by one thread. Samples of a counter that failed to register are dropped
+        inline void AddSample(CounterId counter, float value) { if (IsValidCounter(counter)) m_Counters[counter]->AddSample(value); }
+
+        inline uint32_t GetCounterCount() const { return m_CounterCount.load(std::memory_order_acquire); }
+        inline bool IsValidCounter(CounterId counter) const { return counter < GetCounterCount(); }
+
+        // A counter that failed to register reads as an empty one
+        inline const CounterHistory& GetCounter(CounterId counter) const { return IsValidCounter(counter) ? *m_Counters[counter] : s_EmptyCounter; }
+        inline CounterSummary GetCounterSummary(CounterId counter, uint32_t windowSize = CounterHistory::DEFAULT_WINDOW_SIZE) const { return GetCounter(counter).GetSummary(windowSize); }
+
+        inline CounterId GetCpuTimeCounter() const { return m_CpuTimeCounter; }
+        inline CounterId GetGpuTimeCounter() const { return m_GpuTimeCounter; }
+        inline CounterId GetFrameTimeCounter() const { return m_FrameTimeCounter; }
+
+        inline uint64_t GetFrameTimeHistogramBucket(uint32_t bucket) const { return m_FrameTimeHistogram[bucket].load(std::memory_order_relaxed); }
+        inline uint64_t GetHitchCount() const { return m_HitchCount.load(std::memory_order_acquire); }
+        inline void SetHitchFactor(float factor) { m_HitchFactor = factor; }
+
+        // Summaries, the histogram, recorded hitches and the raw samples of every counter as JSON
+        bool DumpToFile(const std::string& path) const;
+
+        // Dumps are written by the application after the frame ends, not in the middle of a system update
+        inline void RequestDump() { m_DumpRequested.store(true, std::memory_order_relaxed); }
+        inline bool ConsumeDumpRequest() { return m_DumpRequested.exchange(false, std::memory_order_relaxed); }
 
         private:
         Timer m_CpuTimer;
 
-        float m_CpuTime = 0.0f;
-        float m_GpuTime = 0.0f;
-        float m_RamUsage = 0.0f;
+        Utils::Memory::ProcessMemoryInfo m_ProcessMemory;
+        AllocationStats m_FrameAllocationStats;
+        std::vector<GpuRegionTime> m_GpuRegionTimes;
+        GpuPipelineStatistics m_GpuPipelineStatistics = {};
+
+        static inline const CounterHistory s_EmptyCounter{ "" };
+
+        // Counters are never removed, so readers only need the count to see fully constructed ones
+        std::array<Unique<CounterHistory>, MAX_COUNTERS> m_Counters;
+        std::atomic<uint32_t> m_CounterCount = 0;
+        std::mutex m_RegisterMutex;
+
+        CounterId m_CpuTimeCounter;
+        CounterId m_GpuTimeCounter;
+        CounterId m_FrameTimeCounter;
+        CounterId m_RamUsageCounter;
+
+        // Region names are string literals, so the renderer's counters are looked up by pointer
+        std::vector<std::pair<const char*, CounterId>> m_GpuRegionCounters;
+
+        // Frame time histogram, hitches, only written by the thread calling EndFrame
+        std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKET_COUNT> m_FrameTimeHistogram = {};
+        RollingStatistics<HITCH_WINDOW_SIZE> m_HitchWindow;
+        std::array<FrameHitch, MAX_RECORDED_HITCHES> m_Hitches = {};
+        std::atomic<uint64_t> m_HitchCount = 0;
+        float m_HitchFactor = DEFAULT_HITCH_FACTOR;
+        uint64_t m_FrameIndex = 0;
+        Timer m_HitchWarningTimer;
+
+        std::atomic<bool> m_DumpRequested = false;
     };
-}
\ No newline at end of file
+}
@@ -7,6 +7,7 @@
 
 #include "Core/PCH.hpp"
 #include "Core/Window.hpp"
+#include "Platform/Headless/HeadlessWindow.hpp"
 #ifdef PLATFORM_WINDOWS
     #include "Platform/Windows/WindowsWindow.hpp"
 #endif
@@ -16,7 +17,13 @@ namespace ThatEngine
     Unique<Window> Window::Create(const WindowProperties& properties)
     {
         #ifdef PLATFORM_WINDOWS
-        return CreateUnique<WindowsWindow>(properties);
+        if (!properties.IsHeadless)
+        {
+            return CreateUnique<WindowsWindow>(properties);
+        }
         #endif
+
+        // Only backend on platforms without a native window implementation
+        return CreateUnique<HeadlessWindow>(properties);
     }
 }
\ No newline at end of file
@@ -22,6 +22,8 @@ namespace ThatEngine
         uint32_t InnerWidth;
         uint32_t InnerHeight;
         bool IsFocused;
+        bool IsHeadless = false;            // No operating system window, input comes from InputScriptPath
+        std::string InputScriptPath;
     
         WindowProperties(const std::string& title = "That Engine", uint32_t width = 1600, uint32_t height = 900, bool isFocused = true)
             : Title(title), InnerWidth(width), InnerHeight(height), IsFocused(isFocused)
@@ -12,7 +12,7 @@ int main(int argc, char** argv)
 {
     ThatEngine::Application& app = ThatEngine::Application::Get();
     
-    if (!app.Init())
+    if (!app.Init(argc, argv))
     {
         return -1;
     }
@@ -0,0 +1,173 @@
+//
+// File: HeadlessWindow.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Platform/Headless/HeadlessWindow.hpp"
+#include "Core/Event/MouseEvent.hpp"
+#include "Core/Event/KeyboardEvent.hpp"
+
+#include <algorithm>
+
+namespace ThatEngine
+{
+    HeadlessWindow::HeadlessWindow(const WindowProperties& properties)
+        : m_Title(properties.Title), m_Width(properties.InnerWidth), m_Height(properties.InnerHeight), m_IsCursorLocked(properties.IsFocused)
+    {
+        THAT_CORE_INFO("Window: Headless initialization {{ Title: \"{}\", Width: {}, Height: {} }}", properties.Title, properties.InnerWidth, properties.InnerHeight);
+
+        if (!properties.InputScriptPath.empty() && LoadInputScript(properties.InputScriptPath, m_Script))
+        {
+            THAT_CORE_INFO("Window: Loaded {} scripted inputs from \"{}\"", m_Script.size(), properties.InputScriptPath);
+        }
+    }
+
+    // One update is one frame, inputs scripted for it are sent in script order
+    void HeadlessWindow::Update()
+    {
+        while (m_NextInput < m_Script.size() && m_Script[m_NextInput].Frame <= m_Frame)
+        {
+            DispatchInput(m_Script[m_NextInput++]);
+        }
+
+        UpdateMouseDelta();
+        m_Frame++;
+    }
+
+    void HeadlessWindow::UpdateMouseDelta()
+    {
+        if (m_AccumulatedMouseDelta.x == 0 && m_AccumulatedMouseDelta.y == 0) return;
+
+        RawMouseMoveEvent rawMouseMove(m_AccumulatedMouseDelta.x, m_AccumulatedMouseDelta.y);
+        m_InputEventCallback(rawMouseMove);
+
+        m_AccumulatedMouseDelta = glm::vec2(0.0f);
+    }
+
+    void HeadlessWindow::ShowError(const char* errorMessage) const
+    {
+        THAT_CORE_ERROR(errorMessage);
+    }
+
+    void HeadlessWindow::DispatchInput(const ScriptedInput& input)
+    {
+        if (!m_InputEventCallback) return;
+
+        const uint32_t x = static_cast<uint32_t>(m_MousePosition.x);
+        const uint32_t y = static_cast<uint32_t>(m_MousePosition.y);
+
+        switch (input.Type)
+        {
+            case ScriptedInputType::KeyDown:
+            {
+                KeyDownEvent event(input.Code);
+                m_InputEventCallback(event);
+                break;
+            }
+
+            case ScriptedInputType::KeyUp:
+            {
+                KeyUpEvent event(input.Code);
+                m_InputEventCallback(event);
+                break;
+            }
+
+            case ScriptedInputType::MouseButtonDown:
+            {
+                MouseButtonDownEvent event(input.Code, x, y);
+                m_InputEventCallback(event);
+                break;
+            }
+
+            case ScriptedInputType::MouseButtonUp:
+            {
+                MouseButtonUpEvent event(input.Code, x, y);
+                m_InputEventCallback(event);
+                break;
+            }
+
+            case ScriptedInputType::MouseMove:
+            {
+                m_MousePosition = glm::vec2(input.X, input.Y);
+                MouseMoveEvent event(static_cast<uint32_t>(input.X), static_cast<uint32_t>(input.Y));
+                m_InputEventCallback(event);
+                break;
+            }
+
+            // Accumulated like raw input of a real window, sent once per update
+            case ScriptedInputType::RawMouseMove:
+            {
+                m_AccumulatedMouseDelta += glm::vec2(input.X, input.Y);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    bool HeadlessWindow::LoadInputScript(const std::string& path, std::vector<ScriptedInput>& script)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            THAT_CORE_ERROR("Window: Failed to open input script \"{}\"!", path);
+            return false;
+        }
+
+        std::string line;
+        uint32_t lineNumber = 0;
+        while (std::getline(file, line))
+        {
+            lineNumber++;
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream stream(line);
+            std::string typeName;
+            ScriptedInput input = {};
+            stream >> input.Frame >> typeName;
+
+            uint32_t typeIndex = 0;
+            while (typeIndex < static_cast<uint32_t>(ScriptedInputType::Count) && typeName != ScriptedInputTypeNames[typeIndex])
+            {
+                typeIndex++;
+            }
+
+            if (stream.fail() || typeIndex == static_cast<uint32_t>(ScriptedInputType::Count))
+            {
+                THAT_CORE_WARN("Window: Skipping invalid input script line {}: \"{}\"", lineNumber, line);
+                continue;
+            }
+
+            input.Type = static_cast<ScriptedInputType>(typeIndex);
+            if (input.Type == ScriptedInputType::MouseMove || input.Type == ScriptedInputType::RawMouseMove)
+            {
+                stream >> input.X >> input.Y;
+            }
+
+            else
+            {
+                stream >> input.Code;
+            }
+
+            if (stream.fail())
+            {
+                THAT_CORE_WARN("Window: Skipping invalid input script line {}: \"{}\"", lineNumber, line);
+                continue;
+            }
+
+            script.push_back(input);
+        }
+
+        // Stable so inputs of the same frame keep their order
+        std::stable_sort(script.begin(), script.end(), [](const ScriptedInput& first, const ScriptedInput& second)
+        {
+            return first.Frame < second.Frame;
+        });
+
+        return true;
+    }
+}
@@ -0,0 +1,87 @@
+//
+// File: HeadlessWindow.hpp
+// Description: Window without an operating system window for offscreen rendering,
+//              replays input events from a frame-indexed script
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+#include "Core/Window.hpp"
+
+namespace ThatEngine
+{
+    enum class ScriptedInputType : uint32_t
+    {
+        KeyDown,
+        KeyUp,
+        MouseButtonDown,
+        MouseButtonUp,
+        MouseMove,
+        RawMouseMove,
+        Count
+    };
+
+    constexpr const char* ScriptedInputTypeNames[static_cast<uint32_t>(ScriptedInputType::Count)] = { "KeyDown", "KeyUp", "MouseButtonDown", "MouseButtonUp", "MouseMove", "RawMouseMove" };
+
+    // Key and mouse button events use Code, mouse moves use X and Y
+    struct ScriptedInput
+    {
+        uint64_t Frame;
+        ScriptedInputType Type;
+        uint32_t Code;
+        float X;
+        float Y;
+    };
+
+    class HeadlessWindow : public Window
+    {
+        public:
+        HeadlessWindow(const WindowProperties& properties);
+
+        inline const std::string& GetTitle() const override { return m_Title; }
+        inline bool IsMinimized() const override { return false; }
+        inline bool IsFocused() const override { return true; }
+        inline bool IsCursorLocked() const override { return m_IsCursorLocked; }
+        inline uint32_t GetInnerWidth() const override { return m_Width; }
+        inline uint32_t GetInnerHeight() const override { return m_Height; }
+        inline uint32_t GetOuterWidth() const override { return m_Width; }
+        inline uint32_t GetOuterHeight() const override { return m_Height; }
+        inline void* GetNativeWindow() const override { return nullptr; }
+        inline void SetWindowEventCallback(const EventCallbackFn& callback) override { m_WindowEventCallback = callback; }
+        inline void SetInputEventCallback(const EventCallbackFn& callback) override { m_InputEventCallback = callback; }
+        inline glm::vec2 GetMousePosition() const override { return m_MousePosition; }
+
+        void Update() override;
+        void UpdateMouseDelta() override;
+        inline void LockCursor() override { m_IsCursorLocked = true; }
+        inline void UnlockCursor() override { m_IsCursorLocked = false; }
+        void ShowError(const char* errorMessage) const override;
+
+        // Script lines are "<frame> <type> <code>" for keys and buttons, "<frame> <type> <x> <y>" for mouse moves
+        static bool LoadInputScript(const std::string& path, std::vector<ScriptedInput>& script);
+
+        protected:
+        inline void UpdateSizeData() override {}
+
+        private:
+        void DispatchInput(const ScriptedInput& input);
+
+        private:
+        std::string m_Title;
+        uint32_t m_Width;
+        uint32_t m_Height;
+        bool m_IsCursorLocked;
+        glm::vec2 m_MousePosition = glm::vec2(0.0f);
+        glm::vec2 m_AccumulatedMouseDelta = glm::vec2(0.0f);
+        EventCallbackFn m_WindowEventCallback;
+        EventCallbackFn m_InputEventCallback;
+
+        std::vector<ScriptedInput> m_Script; // Sorted by frame
+        uint32_t m_NextInput = 0;
+        uint64_t m_Frame = 0;
+    };
+}
@@ -6,6 +6,9 @@
 //
 
 #include "Core/PCH.hpp"
+
+#ifdef PLATFORM_WINDOWS
+
 #include "Platform/Windows/WindowsWindow.hpp"
 #include "Core/Event/WindowEvent.hpp"
 #include "Core/Event/MouseEvent.hpp"
@@ -393,3 +396,5 @@ namespace ThatEngine
         return { static_cast<float>(point.x), static_cast<float>(point.y) };
     }
 }
+
+#endif
@@ -9,6 +9,9 @@
 #pragma once
 
 #include "Core/PCH.hpp"
+
+#ifdef PLATFORM_WINDOWS
+
 #include "Core/Window.hpp"
 #include "Core/Event/EventDispatcher.hpp"
 
@@ -70,3 +73,5 @@ namespace ThatEngine
         HWND m_Window;
     };
 }
+
+#endif
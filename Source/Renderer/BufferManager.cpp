@@ -12,15 +12,17 @@
 
 namespace ThatEngine
 {
-    void BufferManager::Init(VkContext* context)
+    void BufferManager::Init(VkContext* context, DeviceMemoryAllocator* allocator)
     {
         m_Context = context;
+        m_Allocator = allocator;
     }
 
     Buffer BufferManager::AllocateBuffer(uint32_t dataSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties)
     {
         Buffer buffer = {};
         buffer.Size = dataSize;
+        buffer.Generation = m_NextGeneration.fetch_add(1, std::memory_order_relaxed);
 
         VkBufferCreateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -31,23 +33,18 @@ namespace ThatEngine
         VkMemoryRequirements memoryReqs;
         vkGetBufferMemoryRequirements(m_Context->Device, buffer.Buffer, &memoryReqs);
 
-        uint32_t memoryTypeId = VulkanUtils::GetMemoryTypeIndex(m_Context->Gpu, memoryReqs, memoryProperties);
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.memoryTypeIndex = memoryTypeId;
-        allocInfo.allocationSize = buffer.Size;
-        VK_CHECK(vkAllocateMemory(m_Context->Device, &allocInfo, 0, &buffer.Memory));
-        VK_CHECK(vkBindBufferMemory(m_Context->Device, buffer.Buffer, buffer.Memory, 0));
+        buffer.Allocation = m_Allocator->Allocate(memoryReqs, memoryProperties, DeviceResourceKind::Linear);
+        buffer.Data = buffer.Allocation.Data;
+        VK_CHECK(vkBindBufferMemory(m_Context->Device, buffer.Buffer, buffer.Allocation.Memory, buffer.Allocation.Offset));
 
         return buffer;
     }
 
+    // Host-visible memory is mapped for as long as it lives, so this is a plain copy
     void BufferManager::UploadData(Buffer& buffer, const void* data, uint32_t size, VkDeviceSize offset)
     {
-        buffer.Data = nullptr;
-        VK_CHECK(vkMapMemory(m_Context->Device, buffer.Memory, offset, size, 0, &buffer.Data));
-        memcpy(buffer.Data, data, size);
-        vkUnmapMemory(m_Context->Device, buffer.Memory);
+        THAT_CORE_ASSERT(buffer.Data, "Buffer Manager: Cannot upload data to a buffer that is not host-visible!", 0);
+        memcpy(static_cast<std::byte*>(buffer.Data) + offset, data, size);
     }
 
     void BufferManager::CopyData(VkCommandBuffer& cmd, Buffer& source, Buffer& destination, VkDeviceSize dataSize, VkDeviceSize sourceOffset, VkDeviceSize destinationOffset)
@@ -56,6 +53,12 @@ namespace ThatEngine
         vkCmdCopyBuffer(cmd, source.Buffer, destination.Buffer, 1, &copyRegion);
     }
 
+    void BufferManager::CopyData(VkCommandBuffer& cmd, const UploadAllocation& source, Buffer& destination, VkDeviceSize destinationOffset)
+    {
+        VkBufferCopy copyRegion = { source.Offset, destinationOffset, source.Size };
+        vkCmdCopyBuffer(cmd, source.Buffer, destination.Buffer, 1, &copyRegion);
+    }
+
     void BufferManager::DestroyBuffer(Buffer& buffer)
     {
         if (buffer.Buffer)
@@ -64,10 +67,137 @@ namespace ThatEngine
             buffer.Buffer = VK_NULL_HANDLE;
         }
 
-        if (buffer.Memory)
+        m_Allocator->Free(buffer.Allocation);
+        buffer.Data = nullptr;
+    }
+
+    void BufferManager::RetireBuffer(Buffer& buffer)
+    {
+        RetiredBuffer retired = {};
+        retired.Buffer = buffer;
+        retired.ReleaseFrame = m_UploadRing.FrameCount + m_UploadRing.FrameEnds.size();
+        m_UploadRing.RetiredBuffers.push_back(retired);
+
+        buffer = {};
+    }
+
+    void BufferManager::InitUploadRing(VkDeviceSize size, uint32_t frameCount)
+    {
+        m_UploadRing.Buffer = AllocateBuffer(
+            static_cast<uint32_t>(size),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+        );
+
+        m_UploadRing.Head = 0;
+        m_UploadRing.Tail = 0;
+        m_UploadRing.FrameEnds.assign(frameCount, 0);
+        m_UploadRing.CurrentFrame = 0;
+
+        THAT_CORE_INFO("Buffer Manager: Upload ring of {:.2f} MB for {} frames", static_cast<float>(size) / SIZE_MB(1), frameCount);
+    }
+
+    void BufferManager::ShutdownUploadRing()
+    {
+        for (auto& retired : m_UploadRing.RetiredBuffers)
         {
-            vkFreeMemory(m_Context->Device, buffer.Memory, nullptr);
-            buffer.Memory = VK_NULL_HANDLE;
+            DestroyBuffer(retired.Buffer);
         }
+
+        m_UploadRing.RetiredBuffers.clear();
+        DestroyBuffer(m_UploadRing.Buffer);
+        m_UploadRing.FrameEnds.clear();
+    }
+
+    // Must be called after the frame's fence has signaled
+    void BufferManager::BeginUploadFrame(uint32_t frame)
+    {
+        // Everything up to the end of this frame's previous use is no longer read by the GPU
+        m_UploadRing.Tail = glm::max(m_UploadRing.Tail, m_UploadRing.FrameEnds[frame]);
+        m_UploadRing.CurrentFrame = frame;
+        m_UploadRing.FrameCount++;
+
+        // Every frame that could have used a retired buffer has waited on its fence since
+        std::erase_if(m_UploadRing.RetiredBuffers, [&](RetiredBuffer& retired)
+        {
+            if (retired.ReleaseFrame > m_UploadRing.FrameCount) return false;
+
+            DestroyBuffer(retired.Buffer);
+            return true;
+        });
+    }
+
+    UploadAllocation BufferManager::AllocateUpload(VkDeviceSize size, VkDeviceSize alignment)
+    {
+        // Every frame in flight has to fit its uploads at the same time
+        const VkDeviceSize frameCount = m_UploadRing.FrameEnds.size();
+        if (size * frameCount > m_UploadRing.Buffer.Size)
+        {
+            GrowUploadRing(size * frameCount);
+        }
+
+        VkDeviceSize offset = 0;
+        if (!TryAllocateUpload(size, alignment, offset))
+        {
+            // Frames in flight still hold too much of the ring, a fresh one always fits
+            GrowUploadRing(size * frameCount);
+
+            if (!TryAllocateUpload(size, alignment, offset))
+            {
+                THAT_CORE_ERROR("Buffer Manager: Upload ring cannot allocate {} bytes!", size);
+                return {};
+            }
+        }
+
+        UploadAllocation allocation = {};
+        allocation.Buffer = m_UploadRing.Buffer.Buffer;
+        allocation.Offset = offset;
+        allocation.Size = size;
+        allocation.Data = static_cast<std::byte*>(m_UploadRing.Buffer.Data) + offset;
+
+        return allocation;
+    }
+
+    bool BufferManager::TryAllocateUpload(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+    {
+        const VkDeviceSize capacity = m_UploadRing.Buffer.Size;
+
+        // Align the position inside the buffer, regions never wrap around its end
+        VkDeviceSize position = m_UploadRing.Head % capacity;
+        VkDeviceSize padding = ((position + alignment - 1) & ~(alignment - 1)) - position;
+        if (position + padding + size > capacity)
+        {
+            padding = capacity - position;
+        }
+
+        if (m_UploadRing.Head + padding + size - m_UploadRing.Tail > capacity) return false;
+
+        m_UploadRing.Head += padding;
+        offset = m_UploadRing.Head % capacity;
+
+        m_UploadRing.Head += size;
+        m_UploadRing.FrameEnds[m_UploadRing.CurrentFrame] = m_UploadRing.Head;
+
+        return true;
+    }
+
+    void BufferManager::GrowUploadRing(VkDeviceSize minSize)
+    {
+        VkDeviceSize size = glm::max(minSize, static_cast<VkDeviceSize>(m_UploadRing.Buffer.Size) * 2);
+
+        // Regions handed out before are still read by recorded or in-flight frames
+        RetireBuffer(m_UploadRing.Buffer);
+
+        m_UploadRing.Buffer = AllocateBuffer(
+            static_cast<uint32_t>(size),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+        );
+
+        m_UploadRing.Head = 0;
+        m_UploadRing.Tail = 0;
+        std::fill(m_UploadRing.FrameEnds.begin(), m_UploadRing.FrameEnds.end(), 0);
+
+        THAT_CORE_INFO("Buffer Manager: Upload ring grew to {:.2f} MB", static_cast<float>(size) / SIZE_MB(1));
     }
 }
\ No newline at end of file
@@ -9,22 +9,65 @@
 #pragma once
 
 #include "Renderer/GraphicsContext.hpp"
+#include "Renderer/DeviceMemoryAllocator.hpp"
 #include "Types/BufferTypes.hpp"
 
+#include <vector>
+
 namespace ThatEngine
 {
     class BufferManager
     {
         public:
         BufferManager() = default;
-        void Init(VkContext* content);
+        void Init(VkContext* content, DeviceMemoryAllocator* allocator);
         
         Buffer AllocateBuffer(uint32_t dataSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties);
         void UploadData(Buffer& buffer, const void* data, uint32_t size, VkDeviceSize offset = 0);
         void CopyData(VkCommandBuffer& cmd, Buffer& source, Buffer& destination, VkDeviceSize dataSize, VkDeviceSize sourceOffset, VkDeviceSize destinationOffset);
+        void CopyData(VkCommandBuffer& cmd, const UploadAllocation& source, Buffer& destination, VkDeviceSize destinationOffset = 0);
         void DestroyBuffer(Buffer& buffer);
+        // Destroyed once no frame in flight can use it anymore
+        void RetireBuffer(Buffer& buffer);
+
+        // Persistently mapped ring for per-frame uploads, regions are reclaimed once their frame's fence has signaled,
+        // a ring that is too small is replaced by a bigger one and retired
+        void InitUploadRing(VkDeviceSize size, uint32_t frameCount);
+        void ShutdownUploadRing();
+        void BeginUploadFrame(uint32_t frame);
+        UploadAllocation AllocateUpload(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+        inline VkDeviceSize GetUploadRingSize() const { return m_UploadRing.Buffer.Size; }
+        inline VkDeviceSize GetUploadRingUsedBytes() const { return m_UploadRing.Head - m_UploadRing.Tail; }
+
+        private:
+        bool TryAllocateUpload(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+        void GrowUploadRing(VkDeviceSize minSize);
+
+        private:
+        struct RetiredBuffer
+        {
+            Buffer Buffer;
+            uint64_t ReleaseFrame;
+        };
+
+        struct UploadRing
+        {
+            Buffer Buffer;
+            // Both only ever grow, position in the buffer is the value modulo its size
+            VkDeviceSize Head = 0;
+            VkDeviceSize Tail = 0;
+            // Head at the end of every frame in flight
+            std::vector<VkDeviceSize> FrameEnds;
+            uint32_t CurrentFrame = 0;
+            uint64_t FrameCount = 0;
+            std::vector<RetiredBuffer> RetiredBuffers;
+        };
 
         private:
         VkContext* m_Context;
+        DeviceMemoryAllocator* m_Allocator;
+        UploadRing m_UploadRing;
+        std::atomic<uint64_t> m_NextGeneration = 1;
     };
 }
\ No newline at end of file
@@ -0,0 +1,335 @@
+//
+// File: DeviceMemoryAllocator.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Renderer/Vulkan.hpp"
+#include "Renderer/VulkanUtils.hpp"
+#include "Renderer/DeviceMemoryAllocator.hpp"
+
+namespace ThatEngine
+{
+    void DeviceMemoryAllocator::Init(VkContext* context)
+    {
+        m_Context = context;
+        vkGetPhysicalDeviceMemoryProperties(m_Context->Gpu, &m_MemoryProperties);
+    }
+
+    void DeviceMemoryAllocator::Shutdown()
+    {
+        DeviceMemoryStats stats = GetStats();
+        if (stats.AllocationCount > 0)
+        {
+            THAT_CORE_WARN("Device Memory Allocator: {} allocations ({:.2f} MB) were not freed before shutdown!", stats.AllocationCount, static_cast<float>(stats.UsedBytes) / SIZE_MB(1));
+        }
+
+        for (auto& pool : m_Pools)
+        {
+            for (auto& block : pool.Blocks)
+            {
+                ReleaseBlock(block);
+            }
+        }
+
+        m_Pools.clear();
+    }
+
+    DeviceAllocation DeviceMemoryAllocator::Allocate(const VkMemoryRequirements& memoryReqs, VkMemoryPropertyFlags memoryProperties, DeviceResourceKind kind)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        uint32_t memoryTypeIndex = VulkanUtils::GetMemoryTypeIndex(m_Context->Gpu, memoryReqs, memoryProperties);
+        bool isHostVisible = m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+
+        if (memoryReqs.size > DEDICATED_THRESHOLD)
+        {
+            return AllocateDedicated(memoryReqs.size, memoryTypeIndex, isHostVisible);
+        }
+
+        // Buddy nodes are aligned to their own size, so rounding up to the alignment covers it
+        uint32_t order = GetOrder(glm::max(memoryReqs.size, memoryReqs.alignment));
+        uint32_t poolIndex = GetPoolIndex(memoryTypeIndex, kind);
+        Pool& pool = m_Pools[poolIndex];
+
+        DeviceAllocation allocation = {};
+        allocation.Size = memoryReqs.size;
+        allocation.PoolIndex = poolIndex;
+        allocation.Order = order;
+
+        auto tryAllocate = [&](uint32_t blockIndex) -> bool
+        {
+            Block& block = pool.Blocks[blockIndex];
+            if (!AllocateFromBlock(block, order, allocation.Offset)) return false;
+
+            block.AllocationCount++;
+            block.UsedBytes += memoryReqs.size;
+
+            allocation.Memory = block.Memory;
+            allocation.BlockIndex = blockIndex;
+            allocation.Data = block.Data ? block.Data + allocation.Offset : nullptr;
+
+            return true;
+        };
+
+        for (uint32_t i = 0; i < pool.Blocks.size(); i++)
+        {
+            if (pool.Blocks[i].Memory == VK_NULL_HANDLE) continue;
+            if (tryAllocate(i)) return allocation;
+        }
+
+        // Reuse a released slot before growing the block list
+        uint32_t blockIndex = 0;
+        while (blockIndex < pool.Blocks.size() && pool.Blocks[blockIndex].Memory != VK_NULL_HANDLE)
+        {
+            blockIndex++;
+        }
+
+        if (blockIndex == pool.Blocks.size())
+        {
+            pool.Blocks.emplace_back();
+        }
+
+        // Out of device memory, same as a failed VK_CHECK, callers bind the memory right away and cannot recover
+        if (!CreateBlock(pool, pool.Blocks[blockIndex]) || !tryAllocate(blockIndex))
+        {
+            THAT_CORE_ERROR("Device Memory Allocator: Failed to allocate {} bytes from memory type {}!", memoryReqs.size, memoryTypeIndex);
+            DEBUG_BREAK();
+            return {};
+        }
+
+        return allocation;
+    }
+
+    void DeviceMemoryAllocator::Free(DeviceAllocation& allocation)
+    {
+        if (allocation.Memory == VK_NULL_HANDLE) return;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // Dedicated
+        if (allocation.BlockIndex == INVALID_UINT32_ID)
+        {
+            vkFreeMemory(m_Context->Device, allocation.Memory, nullptr);
+
+            m_DedicatedAllocationCount--;
+            m_DedicatedBytes -= allocation.Size;
+        }
+
+        else
+        {
+            Pool& pool = m_Pools[allocation.PoolIndex];
+            Block& block = pool.Blocks[allocation.BlockIndex];
+
+            FreeToBlock(block, allocation.Order, allocation.Offset);
+            block.AllocationCount--;
+            block.UsedBytes -= allocation.Size;
+
+            // Keep one block per pool around so alternating load and unload does not hit the driver
+            if (block.AllocationCount == 0)
+            {
+                uint32_t liveBlockCount = 0;
+                for (const auto& other : pool.Blocks)
+                {
+                    if (other.Memory != VK_NULL_HANDLE) liveBlockCount++;
+                }
+
+                if (liveBlockCount > 1)
+                {
+                    ReleaseBlock(block);
+                }
+            }
+        }
+
+        allocation = {};
+    }
+
+    DeviceMemoryStats DeviceMemoryAllocator::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        DeviceMemoryStats stats = {};
+        stats.DedicatedAllocationCount = m_DedicatedAllocationCount;
+        stats.AllocationCount = m_DedicatedAllocationCount;
+        stats.ReservedBytes = m_DedicatedBytes;
+        stats.UsedBytes = m_DedicatedBytes;
+
+        // Blocks are separate, so fragmentation only counts free space that is split inside a block
+        VkDeviceSize contiguousFreeBytes = 0;
+
+        for (const auto& pool : m_Pools)
+        {
+            for (const auto& block : pool.Blocks)
+            {
+                if (block.Memory == VK_NULL_HANDLE) continue;
+
+                stats.BlockCount++;
+                stats.AllocationCount += block.AllocationCount;
+                stats.ReservedBytes += BLOCK_SIZE;
+                stats.UsedBytes += block.UsedBytes;
+                stats.InternalWasteBytes += block.NodeBytes - block.UsedBytes;
+                stats.FreeBytes += BLOCK_SIZE - block.NodeBytes;
+
+                // Free buddies never merge further, so the highest non-empty order is the largest free range
+                for (int32_t order = MAX_ORDER; order >= 0; order--)
+                {
+                    if (block.FreeLists[order].empty()) continue;
+
+                    contiguousFreeBytes += MIN_NODE_SIZE << order;
+                    stats.LargestFreeRange = glm::max(stats.LargestFreeRange, MIN_NODE_SIZE << order);
+                    break;
+                }
+            }
+        }
+
+        stats.Fragmentation = stats.FreeBytes > 0 ? 1.0f - static_cast<float>(contiguousFreeBytes) / static_cast<float>(stats.FreeBytes) : 0.0f;
+
+        return stats;
+    }
+
+    void DeviceMemoryAllocator::LogStats()
+    {
+        DeviceMemoryStats stats = GetStats();
+
+        THAT_CORE_INFO("Device Memory Allocator: {} allocations in {} blocks and {} dedicated, {:.2f} MB used of {:.2f} MB reserved",
+            stats.AllocationCount, stats.BlockCount, stats.DedicatedAllocationCount, static_cast<float>(stats.UsedBytes) / SIZE_MB(1), static_cast<float>(stats.ReservedBytes) / SIZE_MB(1));
+        THAT_CORE_INFO("Device Memory Allocator: {:.2f} MB lost to rounding, {:.2f} MB free, {:.1f}% fragmentation",
+            static_cast<float>(stats.InternalWasteBytes) / SIZE_MB(1), static_cast<float>(stats.FreeBytes) / SIZE_MB(1), stats.Fragmentation * 100.0f);
+    }
+
+    uint32_t DeviceMemoryAllocator::GetPoolIndex(uint32_t memoryTypeIndex, DeviceResourceKind kind)
+    {
+        for (uint32_t i = 0; i < m_Pools.size(); i++)
+        {
+            if (m_Pools[i].MemoryTypeIndex == memoryTypeIndex && m_Pools[i].Kind == kind) return i;
+        }
+
+        Pool pool = {};
+        pool.MemoryTypeIndex = memoryTypeIndex;
+        pool.Kind = kind;
+        pool.IsHostVisible = m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        m_Pools.push_back(std::move(pool));
+
+        return static_cast<uint32_t>(m_Pools.size() - 1);
+    }
+
+    bool DeviceMemoryAllocator::CreateBlock(Pool& pool, Block& block)
+    {
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.memoryTypeIndex = pool.MemoryTypeIndex;
+        allocInfo.allocationSize = BLOCK_SIZE;
+
+        if (vkAllocateMemory(m_Context->Device, &allocInfo, nullptr, &block.Memory) != VK_SUCCESS)
+        {
+            block.Memory = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // Host-visible blocks stay mapped for their whole lifetime
+        if (pool.IsHostVisible)
+        {
+            void* data = nullptr;
+            VK_CHECK(vkMapMemory(m_Context->Device, block.Memory, 0, VK_WHOLE_SIZE, 0, &data));
+            block.Data = static_cast<std::byte*>(data);
+        }
+
+        block.FreeLists.assign(MAX_ORDER + 1, {});
+        block.FreeLists[MAX_ORDER].insert(0);
+        block.AllocationCount = 0;
+        block.UsedBytes = 0;
+        block.NodeBytes = 0;
+
+        THAT_CORE_INFO("Device Memory Allocator: Added {:.2f} MB block to memory type {} ({})", 
+            static_cast<float>(BLOCK_SIZE) / SIZE_MB(1), pool.MemoryTypeIndex, pool.Kind == DeviceResourceKind::Linear ? "linear" : "optimal");
+
+        return true;
+    }
+
+    void DeviceMemoryAllocator::ReleaseBlock(Block& block)
+    {
+        if (block.Memory == VK_NULL_HANDLE) return;
+
+        // Freeing implicitly unmaps
+        vkFreeMemory(m_Context->Device, block.Memory, nullptr);
+
+        block = {};
+    }
+
+    bool DeviceMemoryAllocator::AllocateFromBlock(Block& block, uint32_t order, VkDeviceSize& offset)
+    {
+        // Smallest free node that fits
+        uint32_t freeOrder = order;
+        while (freeOrder <= MAX_ORDER && block.FreeLists[freeOrder].empty())
+        {
+            freeOrder++;
+        }
+
+        if (freeOrder > MAX_ORDER) return false;
+
+        // Lowest offset first keeps allocations packed at the start of the block
+        auto iterator = block.FreeLists[freeOrder].begin();
+        offset = *iterator;
+        block.FreeLists[freeOrder].erase(iterator);
+
+        // Split, upper halves become free buddies
+        while (freeOrder > order)
+        {
+            freeOrder--;
+            block.FreeLists[freeOrder].insert(offset + (MIN_NODE_SIZE << freeOrder));
+        }
+
+        block.NodeBytes += MIN_NODE_SIZE << order;
+
+        return true;
+    }
+
+    void DeviceMemoryAllocator::FreeToBlock(Block& block, uint32_t order, VkDeviceSize offset)
+    {
+        block.NodeBytes -= MIN_NODE_SIZE << order;
+
+        // Merge with free buddies as far up as possible
+        while (order < MAX_ORDER)
+        {
+            VkDeviceSize buddy = offset ^ (MIN_NODE_SIZE << order);
+            auto iterator = block.FreeLists[order].find(buddy);
+            if (iterator == block.FreeLists[order].end()) break;
+
+            block.FreeLists[order].erase(iterator);
+            offset = glm::min(offset, buddy);
+            order++;
+        }
+
+        block.FreeLists[order].insert(offset);
+    }
+
+    DeviceAllocation DeviceMemoryAllocator::AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex, bool isHostVisible)
+    {
+        DeviceAllocation allocation = {};
+        allocation.Size = size;
+
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+        allocInfo.allocationSize = size;
+        VK_CHECK(vkAllocateMemory(m_Context->Device, &allocInfo, nullptr, &allocation.Memory));
+
+        if (isHostVisible)
+        {
+            VK_CHECK(vkMapMemory(m_Context->Device, allocation.Memory, 0, VK_WHOLE_SIZE, 0, &allocation.Data));
+        }
+
+        m_DedicatedAllocationCount++;
+        m_DedicatedBytes += size;
+
+        return allocation;
+    }
+
+    uint32_t DeviceMemoryAllocator::GetOrder(VkDeviceSize size)
+    {
+        VkDeviceSize nodeSize = std::bit_ceil(glm::max(size, MIN_NODE_SIZE));
+        return static_cast<uint32_t>(std::countr_zero(nodeSize / MIN_NODE_SIZE));
+    }
+}
@@ -0,0 +1,80 @@
+//
+// File: DeviceMemoryAllocator.hpp
+// Description: Sub-allocates buffer and image memory from large per-memory-type blocks with buddy placement,
+//              large resources get their own dedicated allocation
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Renderer/GraphicsContext.hpp"
+#include "Types/DeviceMemoryTypes.hpp"
+
+#include <bit>
+#include <set>
+#include <vector>
+
+namespace ThatEngine
+{
+    class DeviceMemoryAllocator
+    {
+        public:
+        static constexpr VkDeviceSize BLOCK_SIZE = SIZE_MB(64);
+        static constexpr VkDeviceSize MIN_NODE_SIZE = 256;
+        static constexpr VkDeviceSize DEDICATED_THRESHOLD = BLOCK_SIZE / 2;
+
+        public:
+        DeviceMemoryAllocator() = default;
+        void Init(VkContext* context);
+        void Shutdown();
+
+        DeviceAllocation Allocate(const VkMemoryRequirements& memoryReqs, VkMemoryPropertyFlags memoryProperties, DeviceResourceKind kind);
+        void Free(DeviceAllocation& allocation);
+
+        DeviceMemoryStats GetStats();
+        void LogStats();
+
+        private:
+        struct Block
+        {
+            VkDeviceMemory Memory = VK_NULL_HANDLE;
+            std::byte* Data = nullptr;
+            // Offsets of free nodes, index is the order, node size is MIN_NODE_SIZE << order
+            std::vector<std::set<VkDeviceSize>> FreeLists;
+            uint32_t AllocationCount = 0;
+            VkDeviceSize UsedBytes = 0;
+            VkDeviceSize NodeBytes = 0;
+        };
+
+        struct Pool
+        {
+            uint32_t MemoryTypeIndex;
+            DeviceResourceKind Kind;
+            bool IsHostVisible;
+            // Released blocks keep their slot so allocations can keep referring to blocks by index
+            std::vector<Block> Blocks;
+        };
+
+        uint32_t GetPoolIndex(uint32_t memoryTypeIndex, DeviceResourceKind kind);
+        bool CreateBlock(Pool& pool, Block& block);
+        void ReleaseBlock(Block& block);
+        bool AllocateFromBlock(Block& block, uint32_t order, VkDeviceSize& offset);
+        void FreeToBlock(Block& block, uint32_t order, VkDeviceSize offset);
+        DeviceAllocation AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex, bool isHostVisible);
+
+        static uint32_t GetOrder(VkDeviceSize size);
+
+        private:
+        static constexpr uint32_t MAX_ORDER = std::countr_zero(BLOCK_SIZE / MIN_NODE_SIZE);
+
+        VkContext* m_Context;
+        VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+        std::vector<Pool> m_Pools;
+        std::mutex m_Mutex;
+
+        uint32_t m_DedicatedAllocationCount = 0;
+        VkDeviceSize m_DedicatedBytes = 0;
+    };
+}
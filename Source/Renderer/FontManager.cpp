@@ -8,6 +8,7 @@
 #include "Core/PCH.hpp"
 #include "Renderer/FontManager.hpp"
 #include "Types/ImageTypes.hpp"
+#include "Core/MemoryTracker.hpp"
 
 namespace ThatEngine
 {
@@ -16,6 +17,7 @@ namespace ThatEngine
         m_Context = context;
         m_ImageManager = imageManager;
 
+        ScopedAllocationTag allocationTag(AllocationTag::Font);
         LoadFont(FontAssetType::Default, TextureType::DefaultFont, "Assets/Fonts/Mx437_Verite_9x14.ttf");
     }
 
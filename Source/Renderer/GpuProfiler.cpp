@@ -0,0 +1,213 @@
+//
+// File: GpuProfiler.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Renderer/GpuProfiler.hpp"
+#include "Renderer/VulkanUtils.hpp"
+
+namespace ThatEngine
+{
+    void GpuProfiler::Init(VkContext* context, bool collectPipelineStatistics)
+    {
+        m_Context = context;
+
+        uint32_t queueFamilyCount = 0;
+        std::array<VkQueueFamilyProperties, 8> queueProperties;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_Context->Gpu, &queueFamilyCount, 0);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_Context->Gpu, &queueFamilyCount, queueProperties.data());
+
+        const uint32_t validBits = queueProperties[m_Context->GpuId].timestampValidBits;
+        if (validBits == 0)
+        {
+            THAT_CORE_WARN("GPU Profiler: Graphics queue does not support timestamps, GPU times are not measured!");
+            return;
+        }
+
+        m_TimestampPeriod = m_Context->GpuProperties.limits.timestampPeriod;
+        m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+        // Begin and end timestamp for every region of every frame in flight
+        {
+            VkQueryPoolCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            info.queryCount = GetFirstQuery(m_Context->FramesInFlight);
+            VK_CHECK(vkCreateQueryPool(m_Context->Device, &info, nullptr, &m_QueryPool));
+        }
+
+        // One query per frame in flight spanning the whole frame
+        if (collectPipelineStatistics)
+        {
+            VkQueryPoolCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            info.queryCount = m_Context->FramesInFlight;
+            info.pipelineStatistics = PIPELINE_STATISTIC_FLAGS;
+            VK_CHECK(vkCreateQueryPool(m_Context->Device, &info, nullptr, &m_StatisticsQueryPool));
+        }
+
+        m_Timestamps.resize(MAX_REGIONS_PER_FRAME * 2);
+        m_RegionTimes.reserve(MAX_REGIONS_PER_FRAME);
+
+        // Tracy keeps its own queries and calibrates them with a one-time submit
+        #ifdef TRACY_ENABLE
+        {
+            VkCommandBufferAllocateInfo allocInfo = VulkanUtils::CreateCommandBufferAllocateInfo(m_Context->CommandPool);
+            VkCommandBuffer cmd;
+            VK_CHECK(vkAllocateCommandBuffers(m_Context->Device, &allocInfo, &cmd));
+
+            m_TracyContext = TracyVkContext(m_Context->Gpu, m_Context->Device, m_Context->GraphicsQueue, cmd);
+            vkFreeCommandBuffers(m_Context->Device, m_Context->CommandPool, 1, &cmd);
+        }
+        #endif
+
+        THAT_CORE_INFO("GPU Profiler: {} regions per frame, {:.2f} ns per tick, {} valid timestamp bits, pipeline statistics {}",
+            MAX_REGIONS_PER_FRAME, m_TimestampPeriod, validBits, IsCollectingPipelineStatistics() ? "enabled" : "disabled");
+    }
+
+    void GpuProfiler::Shutdown()
+    {
+        #ifdef TRACY_ENABLE
+        if (m_TracyContext)
+        {
+            TracyVkDestroy(m_TracyContext);
+            m_TracyContext = nullptr;
+        }
+        #endif
+
+        if (m_StatisticsQueryPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(m_Context->Device, m_StatisticsQueryPool, nullptr);
+            m_StatisticsQueryPool = VK_NULL_HANDLE;
+        }
+
+        if (m_QueryPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(m_Context->Device, m_QueryPool, nullptr);
+            m_QueryPool = VK_NULL_HANDLE;
+        }
+    }
+
+    void GpuProfiler::BeginFrame(VkCommandBuffer cmd, uint32_t frame)
+    {
+        m_CurrentFrame = frame;
+        if (!IsEnabled()) return;
+
+        TracyVkCollect(m_TracyContext, cmd);
+
+        // Queries cannot be reset inside a render pass, so all of the frame's queries are reset up front
+        vkCmdResetQueryPool(cmd, m_QueryPool, GetFirstQuery(frame), MAX_REGIONS_PER_FRAME * 2);
+
+        if (IsCollectingPipelineStatistics())
+        {
+            vkCmdResetQueryPool(cmd, m_StatisticsQueryPool, frame, 1);
+            vkCmdBeginQuery(cmd, m_StatisticsQueryPool, frame, 0);
+        }
+
+        FrameRegions& regions = m_Frames[frame];
+        regions.Count.store(0, std::memory_order_relaxed);
+        regions.IsRecorded = true;
+
+        GpuProfileScope::s_CurrentRegion = BeginRegion(cmd, "Frame", INVALID_UINT32_ID);
+    }
+
+    void GpuProfiler::EndFrame(VkCommandBuffer cmd)
+    {
+        if (!IsEnabled()) return;
+
+        EndRegion(cmd, 0);
+        GpuProfileScope::s_CurrentRegion = INVALID_UINT32_ID;
+
+        if (IsCollectingPipelineStatistics())
+        {
+            vkCmdEndQuery(cmd, m_StatisticsQueryPool, m_CurrentFrame);
+        }
+    }
+
+    bool GpuProfiler::Collect(uint32_t frame)
+    {
+        if (!IsEnabled()) return false;
+
+        FrameRegions& regions = m_Frames[frame];
+        if (!regions.IsRecorded) return false;
+
+        const uint32_t regionCount = glm::min(regions.Count.load(std::memory_order_relaxed), MAX_REGIONS_PER_FRAME);
+        if (regionCount == 0) return false;
+
+        // Every region of a recorded frame wrote both of its timestamps, so none of them can be unavailable
+        VkResult result = vkGetQueryPoolResults(m_Context->Device, m_QueryPool, GetFirstQuery(frame), regionCount * 2,
+            regionCount * 2 * sizeof(uint64_t), m_Timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS) return false;
+
+        // Parents always begin before their children, so their depth is already known
+        m_RegionTimes.resize(regionCount);
+        for (uint32_t i = 0; i < regionCount; i++)
+        {
+            const uint64_t ticks = (m_Timestamps[i * 2 + 1] - m_Timestamps[i * 2]) & m_TimestampMask;
+            const uint32_t parent = regions.Parents[i];
+
+            m_RegionTimes[i].Name = regions.Names[i];
+            m_RegionTimes[i].Depth = parent == INVALID_UINT32_ID ? 0 : m_RegionTimes[parent].Depth + 1;
+            m_RegionTimes[i].Time = static_cast<float>(static_cast<double>(ticks) * m_TimestampPeriod / 1e6);
+        }
+
+        if (IsCollectingPipelineStatistics())
+        {
+            vkGetQueryPoolResults(m_Context->Device, m_StatisticsQueryPool, frame, 1,
+                sizeof(GpuPipelineStatistics), &m_PipelineStatistics, sizeof(GpuPipelineStatistics), VK_QUERY_RESULT_64_BIT);
+        }
+
+        regions.IsRecorded = false;
+        return true;
+    }
+
+    uint32_t GpuProfiler::BeginRegion(VkCommandBuffer cmd, const char* name, uint32_t parent)
+    {
+        if (!IsEnabled()) return INVALID_UINT32_ID;
+
+        FrameRegions& regions = m_Frames[m_CurrentFrame];
+        const uint32_t region = regions.Count.fetch_add(1, std::memory_order_relaxed);
+        if (region >= MAX_REGIONS_PER_FRAME) return INVALID_UINT32_ID;
+
+        regions.Names[region] = name;
+        regions.Parents[region] = parent;
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_QueryPool, GetFirstQuery(m_CurrentFrame) + region * 2);
+
+        return region;
+    }
+
+    void GpuProfiler::EndRegion(VkCommandBuffer cmd, uint32_t region)
+    {
+        if (region == INVALID_UINT32_ID) return;
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_QueryPool, GetFirstQuery(m_CurrentFrame) + region * 2 + 1);
+    }
+
+    GpuProfileScope::GpuProfileScope(GpuProfiler& profiler, VkCommandBuffer cmd, const char* name, uint32_t parent)
+        : m_Profiler(profiler), m_CommandBuffer(cmd), m_PreviousRegion(s_CurrentRegion)
+    {
+        m_Region = m_Profiler.BeginRegion(cmd, name, parent);
+        s_CurrentRegion = m_Region;
+
+        #ifdef TRACY_ENABLE
+        if (m_Profiler.GetTracyContext())
+        {
+            m_TracyZone.emplace(m_Profiler.GetTracyContext(), __LINE__, __FILE__, strlen(__FILE__), __FUNCTION__, strlen(__FUNCTION__), name, strlen(name), cmd, true);
+        }
+        #endif
+    }
+
+    GpuProfileScope::~GpuProfileScope()
+    {
+        #ifdef TRACY_ENABLE
+        m_TracyZone.reset();
+        #endif
+
+        m_Profiler.EndRegion(m_CommandBuffer, m_Region);
+        s_CurrentRegion = m_PreviousRegion;
+    }
+}
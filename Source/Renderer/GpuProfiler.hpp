@@ -0,0 +1,113 @@
+//
+// File: GpuProfiler.hpp
+// Description: Measures named, nested GPU regions with timestamp queries and optionally collects pipeline statistics,
+//              every frame in flight has its own queries which are read back once the frame's fence has signaled
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Renderer/GraphicsContext.hpp"
+#include "Core/StatsTracker.hpp"
+
+#include <optional>
+#include <tracy/TracyVulkan.hpp>
+
+namespace ThatEngine
+{
+    class GpuProfiler
+    {
+        public:
+        static constexpr uint32_t MAX_REGIONS_PER_FRAME = 32;
+        static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTIC_FLAGS =
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT; // Results are written in bit order, same as GpuPipelineStatistics
+
+        public:
+        GpuProfiler() = default;
+
+        // Pipeline statistics need the pipelineStatisticsQuery and inheritedQueries features to be enabled
+        void Init(VkContext* context, bool collectPipelineStatistics);
+        void Shutdown();
+
+        // Has to be recorded outside of a render pass, opens the frame region every other region nests in
+        void BeginFrame(VkCommandBuffer cmd, uint32_t frame);
+        void EndFrame(VkCommandBuffer cmd);
+
+        // Reads the results of the last frame recorded into this slot without waiting, its fence has to be signaled
+        bool Collect(uint32_t frame);
+
+        // Thread-safe, returns INVALID_UINT32_ID once the frame is out of regions
+        uint32_t BeginRegion(VkCommandBuffer cmd, const char* name, uint32_t parent);
+        void EndRegion(VkCommandBuffer cmd, uint32_t region);
+
+        inline bool IsEnabled() const { return m_QueryPool != VK_NULL_HANDLE; }
+        inline bool IsCollectingPipelineStatistics() const { return m_StatisticsQueryPool != VK_NULL_HANDLE; }
+        inline VkQueryPipelineStatisticFlags GetInheritedPipelineStatistics() const { return IsCollectingPipelineStatistics() ? PIPELINE_STATISTIC_FLAGS : 0; }
+        inline float GetFrameTime() const { return m_RegionTimes.empty() ? 0.0f : m_RegionTimes[0].Time; }
+        inline const std::vector<GpuRegionTime>& GetRegionTimes() const { return m_RegionTimes; }
+        inline const GpuPipelineStatistics& GetPipelineStatistics() const { return m_PipelineStatistics; }
+        inline TracyVkCtx GetTracyContext() const { return m_TracyContext; }
+
+        private:
+        struct FrameRegions
+        {
+            std::atomic<uint32_t> Count = 0;
+            std::array<const char*, MAX_REGIONS_PER_FRAME> Names;
+            std::array<uint32_t, MAX_REGIONS_PER_FRAME> Parents;
+            bool IsRecorded = false;
+        };
+
+        inline uint32_t GetFirstQuery(uint32_t frame) const { return frame * MAX_REGIONS_PER_FRAME * 2; }
+
+        private:
+        VkContext* m_Context;
+        VkQueryPool m_QueryPool = VK_NULL_HANDLE;
+        VkQueryPool m_StatisticsQueryPool = VK_NULL_HANDLE;
+        float m_TimestampPeriod = 1.0f;     // Nanoseconds per tick
+        uint64_t m_TimestampMask = ~0ull;   // Only timestampValidBits of a timestamp are meaningful
+        TracyVkCtx m_TracyContext = nullptr;
+
+        std::array<FrameRegions, VkContext::MAX_FRAMES_IN_FLIGHT> m_Frames;
+        uint32_t m_CurrentFrame = 0;
+
+        // Results of the last collected frame
+        std::vector<uint64_t> m_Timestamps;
+        std::vector<GpuRegionTime> m_RegionTimes;
+        GpuPipelineStatistics m_PipelineStatistics = {};
+    };
+
+    // Region that ends with the scope, also shows up as a Tracy GPU zone,
+    // regions opened on the same thread nest automatically, other threads have to pass their parent
+    class GpuProfileScope
+    {
+        public:
+        GpuProfileScope(GpuProfiler& profiler, VkCommandBuffer cmd, const char* name, uint32_t parent = GetCurrentRegion());
+        ~GpuProfileScope();
+
+        GpuProfileScope(const GpuProfileScope&) = delete;
+        GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+        static inline uint32_t GetCurrentRegion() { return s_CurrentRegion; }
+
+        private:
+        GpuProfiler& m_Profiler;
+        VkCommandBuffer m_CommandBuffer;
+        uint32_t m_Region;
+        uint32_t m_PreviousRegion;
+
+        #ifdef TRACY_ENABLE
+        std::optional<tracy::VkCtxScope> m_TracyZone;
+        #endif
+
+        static inline thread_local uint32_t s_CurrentRegion = INVALID_UINT32_ID;
+
+        friend class GpuProfiler;
+    };
+}
@@ -16,6 +16,29 @@
 
 namespace ThatEngine
 {
+    // Command pools are externally synchronized, so every recording thread gets its own
+    struct SecondaryCommandPool
+    {
+        VkCommandPool Pool;
+        std::vector<VkCommandBuffer> CommandBuffers; // Allocated on demand, reused after the pool is reset
+        uint32_t UsedCount = 0;
+    };
+
+    // Resources the CPU writes while recording a frame, one copy per frame in flight
+    struct FrameData
+    {
+        VkCommandBuffer CommandBuffer;
+        std::vector<SecondaryCommandPool> SecondaryCommandPools; // Indexed by JobManager::GetCurrentThreadIndex
+        VkSemaphore AcquireSemaphore;
+        VkFence RenderFence;
+
+        Buffer GlobalDataBuffer; // Persistently mapped
+        Buffer InstanceBuffer;  // Grows on demand, each frame reallocates its own copy
+
+        Buffer ReadbackBuffer = {};  // Headless only, receives the final image when frames are read back
+        bool IsReadbackPending = false;
+    };
+
     struct VkContext
     {
         VkInstance Instance;
@@ -23,6 +46,7 @@ namespace ThatEngine
         VkSurfaceFormatKHR SurfaceFormat;
         VkFormat DepthFormat;
         VkPhysicalDevice Gpu;
+        VkPhysicalDeviceProperties GpuProperties;
         VkPhysicalDeviceFeatures GpuFeatures;
         VkPhysicalDeviceFeatures GpuEnabledFeatures;
         uint32_t GpuId;
@@ -30,7 +54,6 @@ namespace ThatEngine
         VkSwapchainKHR Swapchain;
         VkRenderPass RenderPass;
 
-        Shared<PipelineResources> ActivePipeline;        
         VkSampler Sampler;
         VkDescriptorPool DescriptorPool;
         
@@ -42,12 +65,18 @@ namespace ThatEngine
         Shared<Image> SwapchainImages[VkContext::MAX_SWAPCHAIN_IMAGES];
         VkFramebuffer Framebuffers[VkContext::MAX_SWAPCHAIN_IMAGES];
         VkQueue GraphicsQueue;
-        VkCommandBuffer CommandBuffer;
         VkCommandPool CommandPool;
-        
-        VkSemaphore AcquireSemaphore;
-        VkSemaphore SubmitSemaphore;
-        VkFence ImageAvailableFence;
+
+        static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+        uint32_t FramesInFlight;
+        uint32_t CurrentFrame = 0;
+
+        FrameData Frames[VkContext::MAX_FRAMES_IN_FLIGHT];
+
+        // Presentation waits on these, so they belong to the swapchain image and not to the frame, unused when headless
+        VkSemaphore SubmitSemaphores[VkContext::MAX_SWAPCHAIN_IMAGES];
+        // Fence of the frame that last rendered into the swapchain image
+        VkFence ImageFences[VkContext::MAX_SWAPCHAIN_IMAGES] = {};
         
         VkDebugUtilsMessengerEXT Debug;
         VkExtent2D ScreenSize;
@@ -55,9 +84,7 @@ namespace ThatEngine
         VkRect2D Scissor;
         
         Buffer ImageStagingBuffer;
-        Buffer GlobalDataBuffer;
-        Buffer GlobalDataStagingBuffer;
-        Buffer InstanceBuffer;
-        Buffer InstanceStagingBuffer;
+
+        inline FrameData& GetCurrentFrame() { return Frames[CurrentFrame]; }
     };
 }
\ No newline at end of file
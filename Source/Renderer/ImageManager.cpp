@@ -14,9 +14,10 @@
 
 namespace ThatEngine
 {
-    void ImageManager::Init(VkContext* context)
+    void ImageManager::Init(VkContext* context, DeviceMemoryAllocator* allocator)
     {
         m_Context = context;
+        m_Allocator = allocator;
     }
 
     void ImageManager::LoadTextures()
@@ -65,14 +66,8 @@ namespace ThatEngine
         VkMemoryRequirements memoryReqs;
         vkGetImageMemoryRequirements(m_Context->Device, image->Image, &memoryReqs);
 
-        uint32_t memoryTypeId = VulkanUtils::GetMemoryTypeIndex(m_Context->Gpu, memoryReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.memoryTypeIndex = memoryTypeId;
-        allocInfo.allocationSize = memoryReqs.size;
-        VK_CHECK(vkAllocateMemory(m_Context->Device, &allocInfo, 0, &image->Memory));
-        VK_CHECK(vkBindImageMemory(m_Context->Device, image->Image, image->Memory, 0));
+        image->Allocation = m_Allocator->Allocate(memoryReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, DeviceResourceKind::Optimal);
+        VK_CHECK(vkBindImageMemory(m_Context->Device, image->Image, image->Allocation.Memory, image->Allocation.Offset));
 
         return image;
     }
@@ -81,7 +76,6 @@ namespace ThatEngine
     Shared<Image> ImageManager::CreateImage(const uint8_t* data, uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, VkImageUsageFlags usage)
     {
         uint32_t imageSize = width * height * VulkanUtils::GetFormatSize(format);
-        vkMapMemory(m_Context->Device, m_Context->ImageStagingBuffer.Memory, 0, m_Context->ImageStagingBuffer.Size, 0, &m_Context->ImageStagingBuffer.Data);
         memcpy(m_Context->ImageStagingBuffer.Data, data, imageSize);
         
         Shared<Image> image = AllocateImage(width, height, mipLevels, format, usage);
@@ -115,6 +109,7 @@ namespace ThatEngine
         info.viewType = VK_IMAGE_VIEW_TYPE_2D;
 
         VK_CHECK(vkCreateImageView(m_Context->Device, &info, 0, &image->View));
+        image->ViewGeneration = m_NextViewGeneration.fetch_add(1, std::memory_order_relaxed);
     }
 
     void ImageManager::DestroyImage(const Shared<Image>& image)
@@ -131,11 +126,7 @@ namespace ThatEngine
             image->Image = VK_NULL_HANDLE;
         }
 
-        if (image->Memory)
-        {
-            vkFreeMemory(m_Context->Device, image->Memory, nullptr);
-            image->Memory = VK_NULL_HANDLE;
-        }
+        m_Allocator->Free(image->Allocation);
     }
 
     void ImageManager::UploadImageToGPU(const Shared<Image>& image)
@@ -179,8 +170,6 @@ namespace ThatEngine
             mipHeight = glm::max(1u, mipHeight / 2);
         }
 
-        vkUnmapMemory(m_Context->Device, m_Context->ImageStagingBuffer.Memory);
-        
         imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
         imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         imageMemoryBarrier.srcAccessMask = 0;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Renderer/GraphicsContext.hpp"
+#include "Renderer/DeviceMemoryAllocator.hpp"
 #include "Types/ImageTypes.hpp"
 
 namespace ThatEngine
@@ -18,7 +19,7 @@ namespace ThatEngine
     {
         public:
         ImageManager() = default;
-        void Init(VkContext* context);
+        void Init(VkContext* context, DeviceMemoryAllocator* allocator);
         void LoadTextures();
         void Shutdown();
 
@@ -37,6 +38,8 @@ namespace ThatEngine
 
         private:
         VkContext* m_Context;
+        DeviceMemoryAllocator* m_Allocator;
         std::unordered_map<TextureType, Shared<Image>> m_Textures;
+        std::atomic<uint64_t> m_NextViewGeneration = 1;
     };
 }
\ No newline at end of file
@@ -0,0 +1,226 @@
+//
+// File: MeshInstanceStore.cpp
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#include "Core/PCH.hpp"
+#include "Renderer/MeshInstanceStore.hpp"
+#include "Core/FrameAllocator.hpp"
+
+namespace ThatEngine
+{
+    void MeshInstanceStore::Init(VkContext* context, BufferManager* bufferManager)
+    {
+        m_Context = context;
+        m_BufferManager = bufferManager;
+
+        ReserveBuffers(INITIAL_SLOT_CAPACITY);
+    }
+
+    void MeshInstanceStore::Shutdown()
+    {
+        m_BufferManager->DestroyBuffer(m_InstanceBuffer);
+        m_BufferManager->DestroyBuffer(m_BoundsBuffer);
+        m_SlotCapacity = 0;
+        m_ResidentSlotCount = 0;
+
+        m_Instances.clear();
+        m_Bounds.clear();
+        m_Types.clear();
+        m_FreeSlots.clear();
+        m_DirtySlots.clear();
+        m_IsSlotDirty.clear();
+        m_InstanceCounts = {};
+    }
+
+    uint32_t MeshInstanceStore::AllocateSlot(MeshAssetType type)
+    {
+        THAT_CORE_ASSERT(type != MeshAssetType::None && type != MeshAssetType::Count, "Mesh Instance Store: Cannot allocate a slot without a mesh type!", 0);
+
+        uint32_t slot = 0;
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+
+        else
+        {
+            slot = GetSlotCount();
+            m_Instances.emplace_back();
+            m_Bounds.emplace_back();
+            m_Types.emplace_back();
+            m_IsSlotDirty.push_back(false);
+        }
+
+        m_Types[slot] = type;
+        m_InstanceCounts[static_cast<uint32_t>(type)]++;
+
+        // Not drawn until its transform is written
+        m_Instances[slot] = { glm::mat4(1.0f) };
+        m_Bounds[slot] = { glm::vec4(0.0f), INVALID_UINT32_ID };
+        MarkDirty(slot);
+
+        return slot;
+    }
+
+    void MeshInstanceStore::FreeSlot(uint32_t slot)
+    {
+        // Entities can outlive the renderer, their slots are already gone
+        if (m_Types.empty()) return;
+
+        THAT_CORE_ASSERT(slot < GetSlotCount() && m_Types[slot] != MeshAssetType::None, "Mesh Instance Store: Slot {} is not allocated!", slot);
+
+        m_InstanceCounts[static_cast<uint32_t>(m_Types[slot])]--;
+        m_Types[slot] = MeshAssetType::None;
+
+        // Culling skips slots without a draw
+        m_Bounds[slot].DrawIndex = INVALID_UINT32_ID;
+        MarkDirty(slot);
+
+        m_FreeSlots.push_back(slot);
+    }
+
+    void MeshInstanceStore::UpdateSlot(uint32_t slot, const glm::mat4& model, float boundingRadius, bool isActive)
+    {
+        THAT_CORE_ASSERT(slot < GetSlotCount() && m_Types[slot] != MeshAssetType::None, "Mesh Instance Store: Slot {} is not allocated!", slot);
+
+        m_Instances[slot].Model = model;
+        m_Bounds[slot].Sphere = glm::vec4(glm::vec3(model[3]), boundingRadius);
+        m_Bounds[slot].DrawIndex = isActive ? static_cast<uint32_t>(m_Types[slot]) : INVALID_UINT32_ID;
+        MarkDirty(slot);
+    }
+
+    void MeshInstanceStore::Upload(const VkCommandBuffer& cmd)
+    {
+        m_UploadedSlotCount = 0;
+        m_UploadedRangeCount = 0;
+
+        if (m_DirtySlots.empty()) return;
+
+        // New buffers start empty, so every slot has to be written again
+        const bool isGrowing = GetSlotCount() > m_SlotCapacity;
+
+        // Instances first, then bounds, both packed in slot order
+        const VkDeviceSize dirtySlotCount = isGrowing ? GetSlotCount() : m_DirtySlots.size();
+        const VkDeviceSize boundsOffset = sizeof(MeshInstance) * dirtySlotCount;
+
+        UploadAllocation upload = m_BufferManager->AllocateUpload((sizeof(MeshInstance) + sizeof(MeshInstanceBounds)) * dirtySlotCount);
+        if (!upload.Data)
+        {
+            // Slots stay dirty and are tried again next frame, the old buffers stay until the new ones can be filled
+            return;
+        }
+
+        if (isGrowing)
+        {
+            ReserveBuffers(glm::max(GetSlotCount(), m_SlotCapacity * 2));
+
+            for (uint32_t slot = 0; slot < GetSlotCount(); slot++)
+            {
+                MarkDirty(slot);
+            }
+        }
+
+        std::sort(m_DirtySlots.begin(), m_DirtySlots.end());
+
+        std::byte* destination = static_cast<std::byte*>(upload.Data);
+        std::pmr::vector<VkBufferCopy> instanceRegions(FrameAllocator::GetResource());
+        std::pmr::vector<VkBufferCopy> boundsRegions(FrameAllocator::GetResource());
+
+        uint32_t uploadedSlotCount = 0;
+        for (uint32_t i = 0; i < dirtySlotCount;)
+        {
+            // Neighbouring dirty slots are merged into one copy
+            const uint32_t firstSlot = m_DirtySlots[i];
+            uint32_t slotCount = 1;
+
+            while (i + slotCount < dirtySlotCount && m_DirtySlots[i + slotCount] == firstSlot + slotCount)
+            {
+                slotCount++;
+            }
+
+            const VkDeviceSize instanceSource = sizeof(MeshInstance) * uploadedSlotCount;
+            const VkDeviceSize boundsSource = boundsOffset + sizeof(MeshInstanceBounds) * uploadedSlotCount;
+
+            memcpy(destination + instanceSource, &m_Instances[firstSlot], sizeof(MeshInstance) * slotCount);
+            memcpy(destination + boundsSource, &m_Bounds[firstSlot], sizeof(MeshInstanceBounds) * slotCount);
+
+            instanceRegions.push_back({ upload.Offset + instanceSource, sizeof(MeshInstance) * firstSlot, sizeof(MeshInstance) * slotCount });
+            boundsRegions.push_back({ upload.Offset + boundsSource, sizeof(MeshInstanceBounds) * firstSlot, sizeof(MeshInstanceBounds) * slotCount });
+
+            uploadedSlotCount += slotCount;
+            i += slotCount;
+        }
+
+        // Frames submitted earlier may still read the slots that are about to be overwritten
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        vkCmdCopyBuffer(cmd, upload.Buffer, m_InstanceBuffer.Buffer, static_cast<uint32_t>(instanceRegions.size()), instanceRegions.data());
+        vkCmdCopyBuffer(cmd, upload.Buffer, m_BoundsBuffer.Buffer, static_cast<uint32_t>(boundsRegions.size()), boundsRegions.data());
+
+        // Copies have to land before culling reads the bounds and vertex shaders read the instances
+        std::array<VkBufferMemoryBarrier, 2> barriers = {};
+        for (VkBufferMemoryBarrier& barrier : barriers)
+        {
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.offset = 0;
+            barrier.size = VK_WHOLE_SIZE;
+        }
+
+        barriers[0].buffer = m_InstanceBuffer.Buffer;
+        barriers[1].buffer = m_BoundsBuffer.Buffer;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data(), 0, nullptr);
+
+        for (uint32_t slot : m_DirtySlots)
+        {
+            m_IsSlotDirty[slot] = false;
+        }
+
+        m_DirtySlots.clear();
+        m_ResidentSlotCount = GetSlotCount();
+
+        m_UploadedSlotCount = uploadedSlotCount;
+        m_UploadedRangeCount = static_cast<uint32_t>(instanceRegions.size());
+    }
+
+    void MeshInstanceStore::MarkDirty(uint32_t slot)
+    {
+        if (m_IsSlotDirty[slot]) return;
+
+        m_IsSlotDirty[slot] = true;
+        m_DirtySlots.push_back(slot);
+    }
+
+    void MeshInstanceStore::ReserveBuffers(uint32_t slotCount)
+    {
+        // Frames in flight may still read the old buffers
+        if (m_InstanceBuffer.Buffer)
+        {
+            m_BufferManager->RetireBuffer(m_InstanceBuffer);
+            m_BufferManager->RetireBuffer(m_BoundsBuffer);
+        }
+
+        m_InstanceBuffer = m_BufferManager->AllocateBuffer(
+            static_cast<uint32_t>(sizeof(MeshInstance) * slotCount),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+
+        m_BoundsBuffer = m_BufferManager->AllocateBuffer(
+            static_cast<uint32_t>(sizeof(MeshInstanceBounds) * slotCount),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+
+        m_SlotCapacity = slotCount;
+
+        THAT_CORE_INFO("Mesh Instance Store: Capacity of {} slots", slotCount);
+    }
+}
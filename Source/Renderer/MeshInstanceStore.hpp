@@ -0,0 +1,74 @@
+//
+// File: MeshInstanceStore.hpp
+// Description: Keeps mesh instances and their bounds resident on the GPU, every entity owns a stable slot
+//              and only slots that changed since the last frame are uploaded
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Renderer/GraphicsContext.hpp"
+#include "Renderer/BufferManager.hpp"
+#include "Types/MeshTypes.hpp"
+#include "Types/ShaderTypes.hpp"
+
+#include <vector>
+
+namespace ThatEngine
+{
+    class MeshInstanceStore
+    {
+        public:
+        static constexpr uint32_t INITIAL_SLOT_CAPACITY = 4096;
+        static constexpr uint32_t MESH_TYPE_COUNT = static_cast<uint32_t>(MeshAssetType::Count);
+
+        public:
+        MeshInstanceStore() = default;
+        void Init(VkContext* context, BufferManager* bufferManager);
+        void Shutdown();
+
+        // Not thread-safe, slots are only touched from the thread that renders
+        uint32_t AllocateSlot(MeshAssetType type);
+        void FreeSlot(uint32_t slot);
+        void UpdateSlot(uint32_t slot, const glm::mat4& model, float boundingRadius, bool isActive);
+
+        // Records copies of the dirty slots, merged into contiguous ranges
+        void Upload(const VkCommandBuffer& cmd);
+
+        inline const Buffer& GetInstanceBuffer() const { return m_InstanceBuffer; }
+        inline const Buffer& GetBoundsBuffer() const { return m_BoundsBuffer; }
+        inline uint32_t GetSlotCount() const { return static_cast<uint32_t>(m_Instances.size()); }
+        inline uint32_t GetResidentSlotCount() const { return m_ResidentSlotCount; } // Slots written to the buffers at least once
+        inline uint32_t GetInstanceCount(MeshAssetType type) const { return m_InstanceCounts[static_cast<uint32_t>(type)]; }
+        inline uint32_t GetUploadedSlotCount() const { return m_UploadedSlotCount; }
+        inline uint32_t GetUploadedRangeCount() const { return m_UploadedRangeCount; }
+
+        private:
+        void MarkDirty(uint32_t slot);
+        void ReserveBuffers(uint32_t slotCount);
+
+        private:
+        VkContext* m_Context;
+        BufferManager* m_BufferManager;
+
+        Buffer m_InstanceBuffer = {};
+        Buffer m_BoundsBuffer = {};
+        uint32_t m_SlotCapacity = 0;
+        uint32_t m_ResidentSlotCount = 0;
+
+        // CPU copy of every slot, uploads read from here
+        std::vector<MeshInstance> m_Instances;
+        std::vector<MeshInstanceBounds> m_Bounds;
+        std::vector<MeshAssetType> m_Types;
+        std::vector<uint32_t> m_FreeSlots;
+        std::array<uint32_t, MESH_TYPE_COUNT> m_InstanceCounts = {};
+
+        std::vector<uint32_t> m_DirtySlots;
+        std::vector<bool> m_IsSlotDirty;
+
+        uint32_t m_UploadedSlotCount = 0;
+        uint32_t m_UploadedRangeCount = 0;
+    };
+}
@@ -8,113 +8,168 @@
 #include "Core/PCH.hpp"
 #include "Renderer/PipelineManager.hpp"
 #include "Renderer/Vulkan.hpp"
+#include "Core/FrameAllocator.hpp"
 #include "Types/ShaderTypes.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 namespace ThatEngine
 {
-    void PipelineManager::Init(VkContext* context, ShaderManager* shaderManager)
+    void PipelineManager::Init(VkContext* context, ShaderManager* shaderManager, JobManager* jobs)
     {
         m_Context = context; 
         m_ShaderManager = shaderManager;
+        m_Jobs = jobs;
+
+        // Every pipeline below is created through the cache, it is empty when there is nothing usable on disk
+        LoadPipelineCache();
+
+        // Entries exist up front so jobs only ever touch their own pipeline
+        for (uint32_t i = static_cast<uint32_t>(PipelineType::None) + 1; i < static_cast<uint32_t>(PipelineType::Count); i++)
+        {
+            m_Pipelines[static_cast<PipelineType>(i)] = CreateShared<PipelineResources>();
+        }
 
-        // Default lit pipeline
+        // Pipelines are independent, each one loads its shaders and compiles on its own job
+        JobCounter counter;
         {
-            CreatePipeline
-            ({
-                .Name = "Default Lit",
-                .Type = PipelineType::DefaultLit,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::DefaultLit, "Assets/Shaders/DefaultLit.vert.spv", "Assets/Shaders/DefaultLit.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 0,
-            });
+            // Default lit pipeline
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "Default Lit",
+                    .Type = PipelineType::DefaultLit,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::DefaultLit, "Assets/Shaders/DefaultLit.vert.spv", "Assets/Shaders/DefaultLit.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 0,
+                });
+            }, counter);
+
+            // Wireframe variant
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "Default Lit Wireframe",
+                    .Type = PipelineType::DefaultLitWireframe,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::DefaultLit, "Assets/Shaders/DefaultLit.vert.spv", "Assets/Shaders/DefaultLit.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 0,
+                    .PolygonMode = VK_POLYGON_MODE_LINE
+                });
+            }, counter);
+
+            // World-space text pipeline
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "World-space Text",
+                    .Type = PipelineType::WorldSpaceText,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::WorldSpaceText, "Assets/Shaders/WorldSpaceGlyph.vert.spv", "Assets/Shaders/WorldSpaceGlyph.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 0,
+                });
+            }, counter);
+
+            // Wireframe variant
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "World-space Text Wireframe",
+                    .Type = PipelineType::WorldSpaceTextWireframe,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::WorldSpaceText, "Assets/Shaders/WorldSpaceGlyph.vert.spv", "Assets/Shaders/WorldSpaceGlyph.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 0,
+                    .PolygonMode = VK_POLYGON_MODE_LINE,
+                });
+            }, counter);
+
+            // Screen-space text pipeline
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "Screen-space Text",
+                    .Type = PipelineType::ScreenSpaceText,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::ScreenSpaceText, "Assets/Shaders/ScreenSpaceGlyph.vert.spv", "Assets/Shaders/ScreenSpaceGlyph.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 0,
+                });
+            }, counter);
+
+            // Post-processing pipeline
+            m_Jobs->Run([this]()
+            {
+                CreatePipeline
+                ({
+                    .Name = "Post-processing",
+                    .Type = PipelineType::PostProcessing,
+                    .Program = m_ShaderManager->CreateProgram(ShaderProgramType::PostProcessing, "Assets/Shaders/PostProcessing.vert.spv", "Assets/Shaders/PostProcessing.frag.spv"),
+                    .RenderPass = m_Context->RenderPass,
+                    .SubpassIndex = 1,
+                    .EnableDepthTesting = false,
+                    .HasSwapchainImageSets = true,
+                });
+            }, counter);
+
+            // Mesh culling compute pipeline
+            m_Jobs->Run([this]()
+            {
+                CreateComputePipeline
+                ({
+                    .Name = "Cull Mesh Instances",
+                    .Type = PipelineType::CullMeshInstances,
+                    .Program = m_ShaderManager->CreateComputeProgram(ShaderProgramType::CullMeshInstances, "Assets/Shaders/CullMeshInstances.comp.spv"),
+                });
+            }, counter);
+        }
 
+        m_Jobs->Wait(counter);
+
+        // Resource bindings
+        {
             PrepareResourceBinding(PipelineType::DefaultLit, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::DefaultLit, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
             PrepareResourceBinding(PipelineType::DefaultLit, 2, BoundResourceType::Image, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-
-            // Wireframe variant
-            CreatePipeline
-            ({
-                .Name = "Default Lit Wireframe",
-                .Type = PipelineType::DefaultLitWireframe,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::DefaultLit, "Assets/Shaders/DefaultLit.vert.spv", "Assets/Shaders/DefaultLit.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 0,
-                .PolygonMode = VK_POLYGON_MODE_LINE
-            });
+            PrepareResourceBinding(PipelineType::DefaultLit, 3, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
 
             PrepareResourceBinding(PipelineType::DefaultLitWireframe, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::DefaultLitWireframe, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
             PrepareResourceBinding(PipelineType::DefaultLitWireframe, 2, BoundResourceType::Image, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        }
-
-        // World-space text pipeline
-        {
-            CreatePipeline
-            ({
-                .Name = "World-space Text",
-                .Type = PipelineType::WorldSpaceText,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::WorldSpaceText, "Assets/Shaders/WorldSpaceGlyph.vert.spv", "Assets/Shaders/WorldSpaceGlyph.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 0,
-            });
+            PrepareResourceBinding(PipelineType::DefaultLitWireframe, 3, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
 
             PrepareResourceBinding(PipelineType::WorldSpaceText, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::WorldSpaceText, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
             PrepareResourceBinding(PipelineType::WorldSpaceText, 2, BoundResourceType::Image, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
 
-            // Wireframe variant
-            CreatePipeline
-            ({
-                .Name = "World-space Text Wireframe",
-                .Type = PipelineType::WorldSpaceTextWireframe,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::WorldSpaceText, "Assets/Shaders/WorldSpaceGlyph.vert.spv", "Assets/Shaders/WorldSpaceGlyph.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 0,
-                .PolygonMode = VK_POLYGON_MODE_LINE,
-            });
-
             PrepareResourceBinding(PipelineType::WorldSpaceTextWireframe, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::WorldSpaceTextWireframe, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
             PrepareResourceBinding(PipelineType::WorldSpaceTextWireframe, 2, BoundResourceType::Image, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        }
-        
-        // Screen-space text pipeline
-        {
-            CreatePipeline
-            ({
-                .Name = "Screen-space Text",
-                .Type = PipelineType::ScreenSpaceText,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::ScreenSpaceText, "Assets/Shaders/ScreenSpaceGlyph.vert.spv", "Assets/Shaders/ScreenSpaceGlyph.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 0,
-            });
 
             PrepareResourceBinding(PipelineType::ScreenSpaceText, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::ScreenSpaceText, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
             PrepareResourceBinding(PipelineType::ScreenSpaceText, 2, BoundResourceType::Image, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        }
-
-        // Post-processing pipeline
-        {
-            CreatePipeline
-            ({
-                .Name = "Post-processing",
-                .Type = PipelineType::PostProcessing,
-                .Program = m_ShaderManager->CreateProgram(ShaderProgramType::PostProcessing, "Assets/Shaders/PostProcessing.vert.spv", "Assets/Shaders/PostProcessing.frag.spv"),
-                .RenderPass = m_Context->RenderPass,
-                .SubpassIndex = 1,
-                .EnableDepthTesting = false,
-            });
 
             PrepareResourceBinding(PipelineType::PostProcessing, 0, BoundResourceType::UniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             PrepareResourceBinding(PipelineType::PostProcessing, 3, BoundResourceType::ColorInputAttachment, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
             PrepareResourceBinding(PipelineType::PostProcessing, 4, BoundResourceType::DepthInputAttachment, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
+
+            PrepareResourceBinding(PipelineType::CullMeshInstances, 0, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+            PrepareResourceBinding(PipelineType::CullMeshInstances, 1, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+            PrepareResourceBinding(PipelineType::CullMeshInstances, 2, BoundResourceType::StorageBuffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
         }
     }
 
     void PipelineManager::Shutdown()
     {
+        SavePipelineCache();
+        vkDestroyPipelineCache(m_Context->Device, m_PipelineCache, nullptr);
+        m_PipelineCache = VK_NULL_HANDLE;
+
         for (auto& [_, resources] : m_Pipelines)
         {
             vkDestroyDescriptorSetLayout(m_Context->Device, resources->DescriptorSetLayout, nullptr);
@@ -123,16 +178,118 @@ namespace ThatEngine
         }
     }
 
-    void PipelineManager::BindPipeline(const VkCommandBuffer& cmd, PipelineType type)
+    void PipelineManager::LoadPipelineCache()
     {
-        if (m_CurrentBoundPipelineType != type)
+        std::vector<std::byte> data;
+
+        std::ifstream file(PIPELINE_CACHE_PATH, std::ios::binary);
+        if (file.is_open())
         {
-            m_CurrentBoundPipelineType = type;
-            m_Context->ActivePipeline = m_Pipelines[type];
+            PipelineCacheFileHeader header = {};
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            // Size is checked against the file before trusting it with an allocation
+            std::error_code error;
+            const uintmax_t fileSize = std::filesystem::file_size(PIPELINE_CACHE_PATH, error);
+
+            if (file && !error && header.Magic == PIPELINE_CACHE_MAGIC && header.DataSize <= fileSize - sizeof(header))
+            {
+                data.resize(header.DataSize);
+                file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            }
+
+            // Stale or corrupted caches are dropped, the driver may not reject them on its own
+            if (!file || !IsPipelineCacheValid(header, data))
+            {
+                THAT_CORE_WARN("Pipeline Manager: Pipeline cache '{}' does not match this device or driver, starting with an empty one", PIPELINE_CACHE_PATH);
+                data.clear();
+            }
         }
 
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_Context->ActivePipeline->Layout, 0, 1, &m_Context->ActivePipeline->DescriptorSet, 0, 0);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_Context->ActivePipeline->Pipeline);
+        VkPipelineCacheCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        info.initialDataSize = data.size();
+        info.pInitialData = data.empty() ? nullptr : data.data();
+        VK_CHECK(vkCreatePipelineCache(m_Context->Device, &info, nullptr, &m_PipelineCache));
+
+        if (!data.empty())
+        {
+            THAT_CORE_INFO("Pipeline Manager: Loaded pipeline cache '{}' ({:.2f} KB)", PIPELINE_CACHE_PATH, data.size() / 1024.0f);
+        }
+    }
+
+    void PipelineManager::SavePipelineCache()
+    {
+        if (m_PipelineCache == VK_NULL_HANDLE) return;
+
+        size_t dataSize = 0;
+        VK_CHECK(vkGetPipelineCacheData(m_Context->Device, m_PipelineCache, &dataSize, nullptr));
+
+        std::vector<std::byte> data(dataSize);
+        VK_CHECK(vkGetPipelineCacheData(m_Context->Device, m_PipelineCache, &dataSize, data.data()));
+        data.resize(dataSize);
+
+        PipelineCacheFileHeader header = {};
+        header.Magic = PIPELINE_CACHE_MAGIC;
+        header.DriverVersion = m_Context->GpuProperties.driverVersion;
+        header.DataSize = dataSize;
+        memcpy(header.PipelineCacheUUID, m_Context->GpuProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        // Written next to the cache and swapped in, an interrupted write never leaves a truncated cache behind
+        const std::string temporaryPath = std::string(PIPELINE_CACHE_PATH) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+            if (!file)
+            {
+                THAT_CORE_WARN("Pipeline Manager: Failed to write pipeline cache '{}'", temporaryPath);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, PIPELINE_CACHE_PATH, error);
+        if (error)
+        {
+            THAT_CORE_WARN("Pipeline Manager: Failed to replace pipeline cache '{}': {}", PIPELINE_CACHE_PATH, error.message());
+            return;
+        }
+
+        THAT_CORE_INFO("Pipeline Manager: Saved pipeline cache '{}' ({:.2f} KB)", PIPELINE_CACHE_PATH, dataSize / 1024.0f);
+    }
+
+    bool PipelineManager::IsPipelineCacheValid(const PipelineCacheFileHeader& header, const std::vector<std::byte>& data) const
+    {
+        const VkPhysicalDeviceProperties& properties = m_Context->GpuProperties;
+
+        // Our header, caches are only valid for the driver that wrote them
+        if (header.Magic != PIPELINE_CACHE_MAGIC) return false;
+        if (header.DriverVersion != properties.driverVersion) return false;
+        if (memcmp(header.PipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) return false;
+        if (data.size() != header.DataSize || data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+
+        // Header the driver put in front of its own data
+        VkPipelineCacheHeaderVersionOne cacheHeader = {};
+        memcpy(&cacheHeader, data.data(), sizeof(cacheHeader));
+
+        if (cacheHeader.headerSize < sizeof(VkPipelineCacheHeaderVersionOne) || cacheHeader.headerSize > data.size()) return false;
+        if (cacheHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) return false;
+        if (cacheHeader.vendorID != properties.vendorID || cacheHeader.deviceID != properties.deviceID) return false;
+        if (memcmp(cacheHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) return false;
+
+        return true;
+    }
+
+    void PipelineManager::BindPipeline(const VkCommandBuffer& cmd, PipelineType type) const
+    {
+        const PipelineResources& pipeline = *m_Pipelines.at(type);
+        const uint32_t setIndex = m_Context->CurrentFrame * pipeline.SetsPerFrame + (pipeline.SetsPerFrame > 1 ? m_CurrentImage : 0);
+        THAT_CORE_ASSERT(setIndex < pipeline.DescriptorSets.size(), "Pipeline Manager: Descriptor set {} is out of range!", setIndex);
+
+        vkCmdBindDescriptorSets(cmd, pipeline.BindPoint, pipeline.Layout, 0, 1, &pipeline.DescriptorSets[setIndex], 0, 0);
+        vkCmdBindPipeline(cmd, pipeline.BindPoint, pipeline.Pipeline);
     }
 
     void PipelineManager::PrepareResourceBinding(PipelineType type, uint32_t binding, BoundResourceType resourceType, VkDescriptorType descriptorType)
@@ -140,127 +297,157 @@ namespace ThatEngine
         BoundResource resource = {};
         resource.Type = resourceType;
         resource.DescriptorType = descriptorType;
+        resource.Binding = binding;
+        resource.Descriptors.resize(m_Pipelines[type]->DescriptorSets.size());
 
         m_Pipelines[type]->BoundResources[binding] = resource;
     }
 
     void PipelineManager::BindImageResource(PipelineType type, uint32_t binding, const Shared<Image>& image)
     {
-        m_Pipelines[type]->BoundResources[binding].ImageInfo =
+        const VkDescriptorImageInfo info =
         {
             .sampler = m_Context->Sampler,
             .imageView = image->View,
             .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
         };
+
+        for (BoundDescriptor& descriptor : m_Pipelines[type]->BoundResources[binding].Descriptors)
+        {
+            SetImageInfo(descriptor, info, image->ViewGeneration);
+        }
     }
 
-    void PipelineManager::BindInputAttachmentResource(PipelineType type, uint32_t binding, const Shared<Image>& image, VkImageLayout imageLayout)
+    void PipelineManager::BindInputAttachmentResource(PipelineType type, uint32_t binding, const Shared<Image>& image, VkImageLayout imageLayout, uint32_t imageIndex)
     {
-        m_Pipelines[type]->BoundResources[binding].ImageInfo = 
+        PipelineResources& resources = *m_Pipelines[type];
+        THAT_CORE_ASSERT(imageIndex < resources.SetsPerFrame, "Pipeline Manager: Pipeline has no descriptor set for swapchain image {}!", imageIndex);
+
+        const VkDescriptorImageInfo info =
         {
             .sampler = VK_NULL_HANDLE,
             .imageView = image->View,
             .imageLayout = imageLayout,
         };
+
+        for (uint32_t frame = 0; frame < m_Context->FramesInFlight; frame++)
+        {
+            SetImageInfo(resources.BoundResources[binding].Descriptors[frame * resources.SetsPerFrame + imageIndex], info, image->ViewGeneration);
+        }
     }
 
     void PipelineManager::BindBufferResource(PipelineType type, uint32_t binding, Buffer buffer, VkDeviceSize offset, VkDeviceSize range)
     {
-        m_Pipelines[type]->BoundResources[binding].BufferInfo =
+        PipelineResources& resources = *m_Pipelines[type];
+
+        const VkDescriptorBufferInfo info =
         {
             .buffer = buffer.Buffer,
             .offset = offset,
             .range = range
         };
+
+        for (uint32_t i = 0; i < resources.SetsPerFrame; i++)
+        {
+            SetBufferInfo(resources.BoundResources[binding].Descriptors[m_Context->CurrentFrame * resources.SetsPerFrame + i], info, buffer.Generation);
+        }
     }
 
+    void PipelineManager::UpdatePipelineBoundBufferOffset(PipelineType type, uint32_t binding, VkDeviceSize offset)
+    {
+        PipelineResources& resources = *m_Pipelines.at(type);
+
+        for (uint32_t i = 0; i < resources.SetsPerFrame; i++)
+        {
+            BoundDescriptor& descriptor = resources.BoundResources.at(binding).Descriptors[m_Context->CurrentFrame * resources.SetsPerFrame + i];
+            
+            VkDescriptorBufferInfo info = descriptor.BufferInfo;
+            info.offset = offset;
+            SetBufferInfo(descriptor, info, descriptor.Generation);
+        }
+    }
+
+    // Only the current frame's sets are written, the others may still be in use by the GPU
     void PipelineManager::UpdateDescriptorSets()
     {
-        for (const auto& [type, resources] : m_Pipelines)
+        std::pmr::vector<VkWriteDescriptorSet> writes(FrameAllocator::GetResource());
+
+        for (auto& [type, resources] : m_Pipelines)
         {
             if (!m_ActivePipelines.test(static_cast<uint32_t>(type))) continue;
 
-            std::vector<VkWriteDescriptorSet> writes;
-            writes.reserve(resources->BoundResources.size());
-
-            for (const auto& [binding, resource] : resources->BoundResources)
+            for (uint32_t i = 0; i < resources->SetsPerFrame; i++)
             {
-                VkWriteDescriptorSet write = {};
-                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                write.dstSet = resources->DescriptorSet;
-                write.dstBinding = binding;
-                write.descriptorCount = 1;
-                write.descriptorType = resource.DescriptorType;
-
-                switch (resource.Type)
+                const uint32_t setIndex = m_Context->CurrentFrame * resources->SetsPerFrame + i;
+
+                for (auto& [binding, resource] : resources->BoundResources)
                 {
-                    case BoundResourceType::Image:
-                    case BoundResourceType::ColorInputAttachment:
-                    case BoundResourceType::DepthInputAttachment:
-                    {
-                        write.pImageInfo = &resource.ImageInfo;
-                        break;
-                    }
+                    BoundDescriptor& descriptor = resource.Descriptors[setIndex];
+                    if (!descriptor.IsDirty) continue;
+
+                    VkWriteDescriptorSet write = {};
+                    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    write.dstSet = resources->DescriptorSets[setIndex];
+                    write.dstBinding = binding;
+                    write.descriptorCount = 1;
+                    write.descriptorType = resource.DescriptorType;
 
-                    case BoundResourceType::UniformBuffer:
-                    case BoundResourceType::StorageBuffer:
+                    switch (resource.Type)
                     {
-                        write.pBufferInfo = &resource.BufferInfo;
-                        break;
+                        case BoundResourceType::Image:
+                        case BoundResourceType::ColorInputAttachment:
+                        case BoundResourceType::DepthInputAttachment:
+                        {
+                            write.pImageInfo = &descriptor.ImageInfo;
+                            break;
+                        }
+
+                        case BoundResourceType::UniformBuffer:
+                        case BoundResourceType::StorageBuffer:
+                        {
+                            write.pBufferInfo = &descriptor.BufferInfo;
+                            break;
+                        }
                     }
-                }
 
-                writes.emplace_back(write);
+                    writes.emplace_back(write);
+                    descriptor.IsDirty = false;
+                }
             }
-
-            vkUpdateDescriptorSets(m_Context->Device, writes.size(), writes.data(), 0, nullptr); 
         }
-    }
 
-    void PipelineManager::UpdatePipelineBoundBufferOffset(PipelineType type, uint32_t binding, VkDeviceSize offset)
-    {
-        m_Pipelines.at(type)->BoundResources[binding].BufferInfo.offset = offset;
+        TracyPlot("Descriptor Writes", static_cast<int64_t>(writes.size()));
+        if (writes.empty()) return;
+
+        vkUpdateDescriptorSets(m_Context->Device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr); 
     }
 
-    bool PipelineManager::CreatePipeline(const PipelineCreateInfo& pipelineInfo)
+    // Descriptors keep their pending info, rebinding what a set already holds does not dirty it.
+    // Handles alone are not enough, a resource destroyed and created again can reuse its handle value
+    void PipelineManager::SetImageInfo(BoundDescriptor& descriptor, const VkDescriptorImageInfo& info, uint64_t generation)
     {
-        m_Pipelines[pipelineInfo.Type] = CreateShared<PipelineResources>();
-        PipelineResources* resources = m_Pipelines.at(pipelineInfo.Type).get();
-
-        // Descriptor Set Layout
-        VkDescriptorSetLayout descriptorSetLayout;
-        {
-            VkDescriptorSetLayoutCreateInfo info = {};
-            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-            info.pBindings = pipelineInfo.Program->MergedDescriptorBindings.data();
-            info.bindingCount = static_cast<uint32_t>(pipelineInfo.Program->MergedDescriptorBindings.size());
+        if (descriptor.Generation == generation && descriptor.ImageInfo.sampler == info.sampler && descriptor.ImageInfo.imageView == info.imageView && descriptor.ImageInfo.imageLayout == info.imageLayout) return;
 
-            VK_CHECK(vkCreateDescriptorSetLayout(m_Context->Device, &info, nullptr, &resources->DescriptorSetLayout));
-        }
+        descriptor.ImageInfo = info;
+        descriptor.Generation = generation;
+        descriptor.IsDirty = true;
+    }
 
-        // Descriptor Set
-        {
-            VkDescriptorSetAllocateInfo allocInfo = {};
-            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            allocInfo.descriptorPool = m_Context->DescriptorPool;
-            allocInfo.descriptorSetCount = 1;
-            allocInfo.pSetLayouts = &resources->DescriptorSetLayout;
+    void PipelineManager::SetBufferInfo(BoundDescriptor& descriptor, const VkDescriptorBufferInfo& info, uint64_t generation)
+    {
+        if (descriptor.Generation == generation && descriptor.BufferInfo.buffer == info.buffer && descriptor.BufferInfo.offset == info.offset && descriptor.BufferInfo.range == info.range) return;
 
-            VK_CHECK(vkAllocateDescriptorSets(m_Context->Device, &allocInfo, &resources->DescriptorSet));
-        }
+        descriptor.BufferInfo = info;
+        descriptor.Generation = generation;
+        descriptor.IsDirty = true;
+    }
 
-        // Pipeline layout
-        VkPipelineLayout pipelineLayout;
-        {
-            VkPipelineLayoutCreateInfo info = {};
-            info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-            info.setLayoutCount = 1;
-            info.pSetLayouts = &resources->DescriptorSetLayout;
-            info.pPushConstantRanges = pipelineInfo.Program->MergedPushConstantRanges.data();
-            info.pushConstantRangeCount = static_cast<uint32_t>(pipelineInfo.Program->MergedPushConstantRanges.size());
+    bool PipelineManager::CreatePipeline(const PipelineCreateInfo& pipelineInfo)
+    {
+        PipelineResources* resources = m_Pipelines.at(pipelineInfo.Type).get();
+        resources->SetsPerFrame = pipelineInfo.HasSwapchainImageSets ? VkContext::MAX_SWAPCHAIN_IMAGES : 1;
 
-            VK_CHECK(vkCreatePipelineLayout(m_Context->Device, &info, nullptr, &resources->Layout));
-        }
+        CreatePipelineLayout(resources, pipelineInfo.Program);
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -370,11 +557,80 @@ namespace ThatEngine
             info.renderPass = pipelineInfo.RenderPass;
             info.subpass = pipelineInfo.SubpassIndex;
 
-            VK_CHECK(vkCreateGraphicsPipelines(m_Context->Device, VK_NULL_HANDLE, 1, &info, nullptr, &resources->Pipeline));
+            VK_CHECK(vkCreateGraphicsPipelines(m_Context->Device, m_PipelineCache, 1, &info, nullptr, &resources->Pipeline));
         }
 
         THAT_CORE_INFO("Pipeline Manager: Loading Asset \"{}\"", pipelineInfo.Name);
 
         return true;      
     }
+
+    bool PipelineManager::CreateComputePipeline(const ComputePipelineCreateInfo& pipelineInfo)
+    {
+        PipelineResources* resources = m_Pipelines.at(pipelineInfo.Type).get();
+        resources->BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+
+        CreatePipelineLayout(resources, pipelineInfo.Program);
+
+        VkPipelineShaderStageCreateInfo computeShaderStage = {};
+        computeShaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        computeShaderStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        computeShaderStage.module = pipelineInfo.Program->Compute->Handle;
+        computeShaderStage.pName = pipelineInfo.Program->Compute->EntryPoint.c_str();
+
+        // Pipeline
+        {
+            VkComputePipelineCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            info.stage = computeShaderStage;
+            info.layout = resources->Layout;
+
+            VK_CHECK(vkCreateComputePipelines(m_Context->Device, m_PipelineCache, 1, &info, nullptr, &resources->Pipeline));
+        }
+
+        THAT_CORE_INFO("Pipeline Manager: Loading Asset \"{}\"", pipelineInfo.Name);
+
+        return true;
+    }
+
+    void PipelineManager::CreatePipelineLayout(PipelineResources* resources, const Shared<ShaderProgram>& program)
+    {
+        // Descriptor Set Layout
+        {
+            VkDescriptorSetLayoutCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            info.pBindings = program->MergedDescriptorBindings.data();
+            info.bindingCount = static_cast<uint32_t>(program->MergedDescriptorBindings.size());
+
+            VK_CHECK(vkCreateDescriptorSetLayout(m_Context->Device, &info, nullptr, &resources->DescriptorSetLayout));
+        }
+
+        // Descriptor Sets, SetsPerFrame for every frame in flight
+        {
+            std::vector<VkDescriptorSetLayout> layouts(m_Context->FramesInFlight * resources->SetsPerFrame, resources->DescriptorSetLayout);
+            resources->DescriptorSets.resize(layouts.size());
+
+            VkDescriptorSetAllocateInfo allocInfo = {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = m_Context->DescriptorPool;
+            allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+            allocInfo.pSetLayouts = layouts.data();
+
+            // Descriptor pool is externally synchronized and pipelines are created from several jobs
+            std::lock_guard<std::mutex> lock(m_DescriptorPoolMutex);
+            VK_CHECK(vkAllocateDescriptorSets(m_Context->Device, &allocInfo, resources->DescriptorSets.data()));
+        }
+
+        // Pipeline layout
+        {
+            VkPipelineLayoutCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            info.setLayoutCount = 1;
+            info.pSetLayouts = &resources->DescriptorSetLayout;
+            info.pPushConstantRanges = program->MergedPushConstantRanges.data();
+            info.pushConstantRangeCount = static_cast<uint32_t>(program->MergedPushConstantRanges.size());
+
+            VK_CHECK(vkCreatePipelineLayout(m_Context->Device, &info, nullptr, &resources->Layout));
+        }
+    }
 }
\ No newline at end of file
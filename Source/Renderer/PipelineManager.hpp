@@ -1,6 +1,6 @@
 //
 // File: PipelineManager.hpp
-// Description: Manages Vulkan Graphics pipelines
+// Description: Manages Vulkan graphics and compute pipelines
 //
 // Copyright (c) 2025 Sneshu
 // All rights reserved.
@@ -10,27 +10,43 @@
 
 #include "Renderer/GraphicsContext.hpp"
 #include "Renderer/ShaderManager.hpp"
+#include "Core/JobManager.hpp"
 #include "Types/PipelineTypes.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ThatEngine
 {
     class PipelineManager
     {
+        public:
+        static constexpr const char* PIPELINE_CACHE_PATH = "PipelineCache.bin";
+        static constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x48435054; // "TPCH"
+
         public:
         PipelineManager() = default;
-        void Init(VkContext* context, ShaderManager* shaderManager);
+        void Init(VkContext* context, ShaderManager* shaderManager, JobManager* jobs);
         void Shutdown();
 
         void PrepareResourceBinding(PipelineType type, uint32_t binding, BoundResourceType resourceType, VkDescriptorType descriptorType);
-        void BindPipeline(const VkCommandBuffer& cmd, PipelineType type);
+        // Only reads pipeline state, secondary command buffers are recorded from several threads at once
+        void BindPipeline(const VkCommandBuffer& cmd, PipelineType type) const;
+        // Images are bound for every frame in flight, input attachments for every frame at the swapchain image
+        // and buffers only for the frame being recorded, as every frame has its own buffers
         void BindImageResource(PipelineType type, uint32_t binding, const Shared<Image>& image);
-        void BindInputAttachmentResource(PipelineType type, uint32_t binding, const Shared<Image>& image, VkImageLayout imageLayout);
+        void BindInputAttachmentResource(PipelineType type, uint32_t binding, const Shared<Image>& image, VkImageLayout imageLayout, uint32_t imageIndex);
         void BindBufferResource(PipelineType type, uint32_t binding, Buffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
-        void UpdateDescriptorSets();
         void UpdatePipelineBoundBufferOffset(PipelineType type, uint32_t binding, VkDeviceSize offset);
 
+        // Writes only the bindings that changed, and only into the sets of the frame being recorded
+        void UpdateDescriptorSets();
+
+        inline void SetCurrentImage(uint32_t imageIndex) { m_CurrentImage = imageIndex; }
+
+        inline void ActivatePipeline(PipelineType type) { m_ActivePipelines.set(static_cast<uint32_t>(type)); }
+        inline VkPipelineLayout GetPipelineLayout(PipelineType type) const { return m_Pipelines.at(type)->Layout; }
+
         template<PipelineType... Types>
         void SetActivePipelines()
         {
@@ -49,14 +65,25 @@ namespace ThatEngine
         }
 
         private:
+        void LoadPipelineCache();
+        void SavePipelineCache();
+        bool IsPipelineCacheValid(const PipelineCacheFileHeader& header, const std::vector<std::byte>& data) const;
         bool CreatePipeline(const PipelineCreateInfo& info);
+        bool CreateComputePipeline(const ComputePipelineCreateInfo& info);
+        void CreatePipelineLayout(PipelineResources* resources, const Shared<ShaderProgram>& program);
+
+        static void SetImageInfo(BoundDescriptor& descriptor, const VkDescriptorImageInfo& info, uint64_t generation);
+        static void SetBufferInfo(BoundDescriptor& descriptor, const VkDescriptorBufferInfo& info, uint64_t generation);
 
         private:
         std::unordered_map<PipelineType, Shared<PipelineResources>> m_Pipelines;
         std::bitset<static_cast<uint32_t>(PipelineType::Count)> m_ActivePipelines;
-        PipelineType m_CurrentBoundPipelineType;
+        uint32_t m_CurrentImage = 0;
+        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+        std::mutex m_DescriptorPoolMutex;
 
         VkContext* m_Context;
         ShaderManager* m_ShaderManager;
+        JobManager* m_Jobs;
     };
 }
\ No newline at end of file
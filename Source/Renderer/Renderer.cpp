@@ -10,13 +10,17 @@
 #include "Renderer/VulkanUtils.hpp"
 #include "Types/DDSFormatTypes.hpp"
 #include "Types/ECSTypes.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Utils/GeometryUtils.hpp"
 
 namespace ThatEngine
 {
-    bool Renderer::Init(Window *window, ResourceManager* resources, StatsTracker& statsTracker)
+    bool Renderer::Init(Window *window, ResourceManager* resources, JobManager* jobs, StatsTracker& statsTracker, const RendererProperties& properties)
     {
         m_Resources = resources;
+        m_Jobs = jobs;
         m_StatsTracker = &statsTracker;
+        m_Properties = properties;
 
         // Set window
         if (!window)
@@ -27,6 +31,7 @@ namespace ThatEngine
            
         m_Window = window;
         m_Resources = resources;
+        m_Context.FramesInFlight = glm::clamp(properties.FramesInFlight, 1u, VkContext::MAX_FRAMES_IN_FLIGHT);
         
         m_PipelineBindOrder = { PipelineType::DefaultLit, PipelineType::WorldSpaceText, PipelineType::ScreenSpaceText, PipelineType::PostProcessing};
         SetScreenSize(window->GetInnerWidth(), window->GetInnerHeight());
@@ -39,13 +44,16 @@ namespace ThatEngine
             appInfo.pApplicationName = m_Window->GetTitle().c_str();
             appInfo.pEngineName = "ThatEngine";
             
-            const char* extensions[] = {
+            std::vector<const char*> extensions = { VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
+
+            // Headless rendering never presents, so it also runs on drivers without any surface support
+            if (!m_Properties.IsHeadless)
+            {
+                extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
                 #ifdef PLATFORM_WINDOWS
-                VK_KHR_WIN32_SURFACE_EXTENSION_NAME,
+                extensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
                 #endif
-                VK_EXT_DEBUG_UTILS_EXTENSION_NAME,
-                VK_KHR_SURFACE_EXTENSION_NAME
-            };
+            }
             
             std::vector<const char*> layers;
 
@@ -56,8 +64,8 @@ namespace ThatEngine
             VkInstanceCreateInfo info = {};
             info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
             info.pApplicationInfo = &appInfo;
-            info.ppEnabledExtensionNames = extensions;
-            info.enabledExtensionCount = ARRAY_SIZE(extensions);
+            info.ppEnabledExtensionNames = extensions.data();
+            info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
             info.ppEnabledLayerNames = layers.data();
             info.enabledLayerCount = layers.size();
             VK_CHECK(vkCreateInstance(&info, 0, &m_Context.Instance));
@@ -79,12 +87,19 @@ namespace ThatEngine
         }
         
         // Surface
+        m_Context.Surface = VK_NULL_HANDLE;
+        if (!m_Properties.IsHeadless)
         {
+            #ifdef PLATFORM_WINDOWS
             VkWin32SurfaceCreateInfoKHR info = {};
             info.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
             info.hwnd = static_cast<HWND>(m_Window->GetNativeWindow());
             info.hinstance = GetModuleHandleA(0);
             VK_CHECK(vkCreateWin32SurfaceKHR(m_Context.Instance, &info, 0, &m_Context.Surface));
+            #else
+            THAT_CORE_ERROR("Vulkan Init: No surface support on this platform, use headless rendering!");
+            return false;
+            #endif
         }
         
         // Choose GPU
@@ -115,8 +130,11 @@ namespace ThatEngine
                 {
                     if (queueProperties[j].queueFlags & VK_QUEUE_GRAPHICS_BIT)
                     {
-                        VkBool32 surfaceSupport = VK_FALSE;
-                        vkGetPhysicalDeviceSurfaceSupportKHR(gpu, j, m_Context.Surface, &surfaceSupport);
+                        VkBool32 surfaceSupport = m_Properties.IsHeadless;
+                        if (!m_Properties.IsHeadless)
+                        {
+                            vkGetPhysicalDeviceSurfaceSupportKHR(gpu, j, m_Context.Surface, &surfaceSupport);
+                        }
                         
                         if (surfaceSupport)
                         {
@@ -131,6 +149,7 @@ namespace ThatEngine
             THAT_CORE_ASSERT(gpuId != INVALID_UINT32_ID, "Vulkan Init: No GPU with a graphics-capable queue family found!", 0);
 
             m_Context.GpuId = gpuId;
+            vkGetPhysicalDeviceProperties(m_Context.Gpu, &m_Context.GpuProperties);
         }
         
         // Logical device
@@ -143,9 +162,11 @@ namespace ThatEngine
             queueInfo.queueCount = 1;
             queueInfo.pQueuePriorities = &queuePriority;
             
-            std::array<const char*, 1> extensions = {
-                VK_KHR_SWAPCHAIN_EXTENSION_NAME
-            };
+            std::vector<const char*> extensions;
+            if (!m_Properties.IsHeadless)
+            {
+                extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+            }
 
             VkPhysicalDeviceFeatures supportedFeatures;
             vkGetPhysicalDeviceFeatures(m_Context.Gpu, &m_Context.GpuFeatures);
@@ -162,6 +183,31 @@ namespace ThatEngine
                 m_Context.GpuEnabledFeatures.fillModeNonSolid = VK_TRUE;
             }
 
+            // Culled mesh draws start at their own region of visible instances
+            if (m_Context.GpuFeatures.drawIndirectFirstInstance != VK_TRUE)
+            {
+                THAT_CORE_ERROR("Vulkan Init: GPU does not support drawIndirectFirstInstance!");
+                return false;
+            }
+
+            m_Context.GpuEnabledFeatures.drawIndirectFirstInstance = VK_TRUE;
+
+            // Secondary command buffers recorded during the statistics query have to inherit it
+            if (m_Properties.CollectPipelineStatistics)
+            {
+                if (m_Context.GpuFeatures.pipelineStatisticsQuery == VK_TRUE && m_Context.GpuFeatures.inheritedQueries == VK_TRUE)
+                {
+                    THAT_CORE_INFO("Vulkan: Pipeline statistics enabled!");
+                    m_Context.GpuEnabledFeatures.pipelineStatisticsQuery = VK_TRUE;
+                    m_Context.GpuEnabledFeatures.inheritedQueries = VK_TRUE;
+                }
+
+                else
+                {
+                    THAT_CORE_WARN("Vulkan: GPU does not support pipeline statistics queries!");
+                }
+            }
+
             VkPhysicalDeviceVulkan12Features features12 = {};
             features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
             features12.separateDepthStencilLayouts = VK_TRUE;
@@ -171,7 +217,7 @@ namespace ThatEngine
             info.pQueueCreateInfos = &queueInfo;
             info.queueCreateInfoCount = 1;
             info.ppEnabledExtensionNames = extensions.data();
-            info.enabledExtensionCount = ARRAY_SIZE(extensions);
+            info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
             info.pEnabledFeatures = &m_Context.GpuEnabledFeatures;
             info.pNext = &features12;
             VK_CHECK(vkCreateDevice(m_Context.Gpu, &info, 0, &m_Context.Device));
@@ -182,13 +228,22 @@ namespace ThatEngine
         // Init resources that only use logical device
         {
             m_Resources->Init(&m_Context);
-            m_GpuTimer.Init(m_Context.Device);
         }
 
         // Formats
         {
             m_Context.DepthFormat = VulkanUtils::FindSupportedFormat(m_Context.Gpu, { VK_FORMAT_D32_SFLOAT });
-            m_Context.SurfaceFormat = VulkanUtils::FindSurfaceFormat(m_Context.Gpu, m_Context.Surface);
+
+            // Offscreen images use the format the swapchain would prefer, so output matches what is presented
+            if (m_Properties.IsHeadless)
+            {
+                m_Context.SurfaceFormat = { VK_FORMAT_B8G8R8A8_SRGB, VK_COLORSPACE_SRGB_NONLINEAR_KHR };
+            }
+
+            else
+            {
+                m_Context.SurfaceFormat = VulkanUtils::FindSurfaceFormat(m_Context.Gpu, m_Context.Surface);
+            }
         }
 
         // Render Pass
@@ -223,7 +278,7 @@ namespace ThatEngine
                 postprocessColorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
                 postprocessColorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
                 postprocessColorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-                postprocessColorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+                postprocessColorAttachment.finalLayout = m_Properties.IsHeadless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
             }
             
             // Subpass 0: Geometry
@@ -300,10 +355,26 @@ namespace ThatEngine
                 depthDependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
             }
             
+            // Color: Postprocess write -> Readback copy, headless only
+            VkSubpassDependency readbackDependency = {};
+            {
+                readbackDependency.srcSubpass = 1;
+                readbackDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+                readbackDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+                readbackDependency.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                readbackDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                readbackDependency.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            }
+            
             // Arrays
             std::array<VkAttachmentDescription, 3> attachments = { colorAttachment, depthAttachment, postprocessColorAttachment };  
             std::array<VkSubpassDescription, 2> subpasses = { geometrySubpass, postprocessSubpass };
-            std::array<VkSubpassDependency, 2> dependencies = { colorDependency, depthDependency };
+            std::vector<VkSubpassDependency> dependencies = { colorDependency, depthDependency };
+
+            if (m_Properties.IsHeadless)
+            {
+                dependencies.push_back(readbackDependency);
+            }
 
             // Render Pass
             VkRenderPassCreateInfo info = {};
@@ -329,6 +400,11 @@ namespace ThatEngine
             VK_CHECK(vkCreateCommandPool(m_Context.Device, &info, 0, &m_Context.CommandPool));
         }
 
+        // GPU profiler, Tracy calibrates its context with a command buffer from the pool
+        {
+            m_GpuProfiler.Init(&m_Context, m_Context.GpuEnabledFeatures.pipelineStatisticsQuery == VK_TRUE);
+        }
+
         // Sampler
         {
             VkSamplerCreateInfo info = {};
@@ -348,14 +424,20 @@ namespace ThatEngine
 
         // Descriptor pool
         {
-            std::array<VkDescriptorPoolSize, 2> poolSizes = {{
-                { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 },
-                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 },
+            // Every pipeline gets one set per frame in flight, culling and the meshes it feeds use several storage buffers,
+            // post-processing gets one per frame and swapchain image
+            const uint32_t setCount = (static_cast<uint32_t>(PipelineType::Count) + VkContext::MAX_SWAPCHAIN_IMAGES - 1) * m_Context.FramesInFlight;
+
+            std::array<VkDescriptorPoolSize, 4> poolSizes = {{
+                { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, setCount },
+                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, setCount * 2 },
+                { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, setCount },
+                { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, setCount * 2 },
             }};
 
             VkDescriptorPoolCreateInfo info = {};
             info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-            info.maxSets = 16; // Pipelines x buffers (no triple buffering for now)
+            info.maxSets = setCount;
             info.poolSizeCount = poolSizes.size();
             info.pPoolSizes = poolSizes.data();
             VK_CHECK(vkCreateDescriptorPool(m_Context.Device, &info, 0, &m_Context.DescriptorPool));
@@ -369,29 +451,37 @@ namespace ThatEngine
                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT      
             );
 
-             m_Context.GlobalDataStagingBuffer = m_Resources->GetBufferManager().AllocateBuffer(
-                256, 
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT      
-            );
-
-            m_Context.GlobalDataBuffer = m_Resources->GetBufferManager().AllocateBuffer(
-                256,
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-            );
+            // Global data and instances are rewritten every frame, so each frame in flight has its own copy
+            for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+            {
+                m_Context.Frames[i].GlobalDataBuffer = m_Resources->GetBufferManager().AllocateBuffer(
+                    sizeof(GlobalData),
+                    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                );
+
+                m_Context.Frames[i].InstanceBuffer = m_Resources->GetBufferManager().AllocateBuffer(
+                    INITIAL_INSTANCE_BUFFER_SIZE,
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                );
+
+                // Headless window never resizes, so the final image size is fixed
+                if (m_Properties.IsHeadless && m_Properties.ReadbackFrames)
+                {
+                    m_Context.Frames[i].ReadbackBuffer = m_Resources->GetBufferManager().AllocateBuffer(
+                        m_Context.ScreenSize.width * m_Context.ScreenSize.height * 4,
+                        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                    );
+                }
+            }
 
-            m_Context.InstanceStagingBuffer = m_Resources->GetBufferManager().AllocateBuffer(
-                sizeof(MeshInstance) * ECS::MAX_ENTITIES, 
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT      
-            );
+            // Staging memory of all frames in flight for instance uploads, grows with them
+            m_Resources->GetBufferManager().InitUploadRing(INITIAL_INSTANCE_BUFFER_SIZE * m_Context.FramesInFlight, m_Context.FramesInFlight);
 
-            m_Context.InstanceBuffer = m_Resources->GetBufferManager().AllocateBuffer(
-                sizeof(MeshInstance) * ECS::MAX_ENTITIES,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-            );
+            // Mesh instances are shared by every frame, only changed slots are uploaded
+            m_MeshInstances.Init(&m_Context, &m_Resources->GetBufferManager());
         }
 
         // Late init resources that use staging buffers
@@ -401,58 +491,69 @@ namespace ThatEngine
 
         // Init pipelines
         {
-            m_PipelineManager.Init(&m_Context, &m_Resources->GetShaderManager());
+            m_PipelineManager.Init(&m_Context, &m_Resources->GetShaderManager(), m_Jobs);
 
             auto& imageManager = m_Resources->GetImageManager();
 
-            // Bind static resources
+            // Bind static resources, global data and instance buffers are bound per frame
             {
                 // Default lit pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::DefaultLit, 0, m_Context.GlobalDataBuffer);
-                m_PipelineManager.BindBufferResource(PipelineType::DefaultLit, 1, m_Context.InstanceBuffer);
                 m_PipelineManager.BindImageResource(PipelineType::DefaultLit, 2, imageManager.GetTexture(TextureType::BlockWhiteTile));
 
                 // Default lit wireframe pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::DefaultLitWireframe, 0, m_Context.GlobalDataBuffer);
-                m_PipelineManager.BindBufferResource(PipelineType::DefaultLitWireframe, 1, m_Context.InstanceBuffer);
                 m_PipelineManager.BindImageResource(PipelineType::DefaultLitWireframe, 2, imageManager.GetTexture(TextureType::BlockWhiteTile));
 
                 // World space text pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::WorldSpaceText, 0, m_Context.GlobalDataBuffer);
-                m_PipelineManager.BindBufferResource(PipelineType::WorldSpaceText, 1, m_Context.InstanceBuffer);
                 m_PipelineManager.BindImageResource(PipelineType::WorldSpaceText, 2, imageManager.GetTexture(TextureType::DefaultFont));
 
                 // World space text wireframe pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::WorldSpaceTextWireframe, 0, m_Context.GlobalDataBuffer);
-                m_PipelineManager.BindBufferResource(PipelineType::WorldSpaceTextWireframe, 1, m_Context.InstanceBuffer);
                 m_PipelineManager.BindImageResource(PipelineType::WorldSpaceTextWireframe, 2, imageManager.GetTexture(TextureType::DefaultFont));
 
                 // Screen space text pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::ScreenSpaceText, 0, m_Context.GlobalDataBuffer);
-                m_PipelineManager.BindBufferResource(PipelineType::ScreenSpaceText, 1, m_Context.InstanceBuffer);
                 m_PipelineManager.BindImageResource(PipelineType::ScreenSpaceText, 2, imageManager.GetTexture(TextureType::DefaultFont));
-            
-                // Post-processing pipeline
-                m_PipelineManager.BindBufferResource(PipelineType::PostProcessing, 0, m_Context.GlobalDataBuffer);
-            }            
+            }
+
+            BindSwapchainAttachments();
         }
         
-        // Command Buffer
+        // Command Buffers
+        for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
         {
             VkCommandBufferAllocateInfo allocInfo = VulkanUtils::CreateCommandBufferAllocateInfo(m_Context.CommandPool);
-            VK_CHECK(vkAllocateCommandBuffers(m_Context.Device, &allocInfo, &m_Context.CommandBuffer)); 
+            VK_CHECK(vkAllocateCommandBuffers(m_Context.Device, &allocInfo, &m_Context.Frames[i].CommandBuffer)); 
+
+            // Secondary command buffers, one pool for every job thread including the one that owns the manager
+            m_Context.Frames[i].SecondaryCommandPools.resize(m_Jobs->GetThreadCount() + 1);
+            for (SecondaryCommandPool& pool : m_Context.Frames[i].SecondaryCommandPools)
+            {
+                VkCommandPoolCreateInfo info = {};
+                info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                info.queueFamilyIndex = m_Context.GpuId;
+                info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                VK_CHECK(vkCreateCommandPool(m_Context.Device, &info, 0, &pool.Pool));
+            }
         }
         
         // Semaphores, fences
         {
             VkSemaphoreCreateInfo semaphoreInfo = {};
             semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-            VK_CHECK(vkCreateSemaphore(m_Context.Device, &semaphoreInfo, 0, &m_Context.AcquireSemaphore));
-            VK_CHECK(vkCreateSemaphore(m_Context.Device, &semaphoreInfo, 0, &m_Context.SubmitSemaphore));
-            
-            m_Context.ImageAvailableFence = VulkanUtils::CreateFence(m_Context.Device, VK_FENCE_CREATE_SIGNALED_BIT);
+
+            for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+            {
+                VK_CHECK(vkCreateSemaphore(m_Context.Device, &semaphoreInfo, 0, &m_Context.Frames[i].AcquireSemaphore));
+                m_Context.Frames[i].RenderFence = VulkanUtils::CreateFence(m_Context.Device, VK_FENCE_CREATE_SIGNALED_BIT);
+            }
+
+            for (uint32_t i = 0; i < VkContext::MAX_SWAPCHAIN_IMAGES; i++)
+            {
+                VK_CHECK(vkCreateSemaphore(m_Context.Device, &semaphoreInfo, 0, &m_Context.SubmitSemaphores[i]));
+            }
         }
 
+        THAT_CORE_INFO("Vulkan: {} frames in flight{}", m_Context.FramesInFlight, m_Properties.IsHeadless ? ", headless" : "");
+        m_Resources->GetDeviceMemoryAllocator().LogStats();
+
         THAT_CORE_INFO("Vulkan: Initialization is complete!");
 
         return true;
@@ -462,7 +563,37 @@ namespace ThatEngine
     {
         vkDeviceWaitIdle(m_Context.Device);
 
-        vkFreeCommandBuffers(m_Context.Device, m_Context.CommandPool, 1, &m_Context.CommandBuffer);
+        // Frames still in flight, oldest first so checksums stay in submission order
+        for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+        {
+            ReadbackFrame(m_Context.Frames[(m_Context.CurrentFrame + i) % m_Context.FramesInFlight]);
+        }
+        WaitForReadback();
+
+        if (!m_FrameChecksums.empty())
+        {
+            uint64_t checksum = FNV_OFFSET_BASIS;
+            for (uint64_t frameChecksum : m_FrameChecksums)
+            {
+                checksum = (checksum ^ frameChecksum) * FNV_PRIME;
+            }
+
+            THAT_CORE_INFO("Renderer: {} frames read back, combined checksum {:016x}", m_FrameChecksums.size(), checksum);
+        }
+
+        for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+        {
+            vkFreeCommandBuffers(m_Context.Device, m_Context.CommandPool, 1, &m_Context.Frames[i].CommandBuffer);
+
+            // Destroying a pool frees its command buffers
+            for (SecondaryCommandPool& pool : m_Context.Frames[i].SecondaryCommandPools)
+            {
+                vkDestroyCommandPool(m_Context.Device, pool.Pool, 0);
+            }
+
+            m_Context.Frames[i].SecondaryCommandPools.clear();
+        }
+
         vkDestroyCommandPool(m_Context.Device, m_Context.CommandPool, 0);   
         vkDestroyRenderPass(m_Context.Device, m_Context.RenderPass, 0);
         vkDestroyDescriptorPool(m_Context.Device, m_Context.DescriptorPool, 0);
@@ -470,29 +601,49 @@ namespace ThatEngine
         
         // Swapchain
         DestroySwapchain();
-        vkDestroySurfaceKHR(m_Context.Instance, m_Context.Surface, 0);
+        if (m_Context.Surface != VK_NULL_HANDLE)
+        {
+            vkDestroySurfaceKHR(m_Context.Instance, m_Context.Surface, 0);
+        }
 
         // Pipelines
         m_PipelineManager.Shutdown();
 
         // Buffers
         m_Resources->GetBufferManager().DestroyBuffer(m_Context.ImageStagingBuffer);
-        m_Resources->GetBufferManager().DestroyBuffer(m_Context.GlobalDataStagingBuffer);
-        m_Resources->GetBufferManager().DestroyBuffer(m_Context.GlobalDataBuffer);
-        m_Resources->GetBufferManager().DestroyBuffer(m_Context.InstanceStagingBuffer);
-        m_Resources->GetBufferManager().DestroyBuffer(m_Context.InstanceBuffer);
+
+        for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+        {
+            m_Resources->GetBufferManager().DestroyBuffer(m_Context.Frames[i].GlobalDataBuffer);
+            m_Resources->GetBufferManager().DestroyBuffer(m_Context.Frames[i].InstanceBuffer);
+
+            if (m_Context.Frames[i].ReadbackBuffer.Buffer != VK_NULL_HANDLE)
+            {
+                m_Resources->GetBufferManager().DestroyBuffer(m_Context.Frames[i].ReadbackBuffer);
+            }
+        }
+
+        m_MeshInstances.Shutdown();
+        m_Resources->GetBufferManager().ShutdownUploadRing();
 
         // Resource manager
         m_Resources->Shutdown();
 
-        // Gpu timer
-        m_GpuTimer.Shutdown();
+        // GPU profiler
+        m_GpuProfiler.Shutdown();
 
         // Async
-        vkWaitForFences(m_Context.Device, 1, &m_Context.ImageAvailableFence, VK_TRUE, UINT64_MAX);
-        vkDestroyFence(m_Context.Device, m_Context.ImageAvailableFence, 0);
-        vkDestroySemaphore(m_Context.Device, m_Context.AcquireSemaphore, 0);
-        vkDestroySemaphore(m_Context.Device, m_Context.SubmitSemaphore, 0);
+        for (uint32_t i = 0; i < m_Context.FramesInFlight; i++)
+        {
+            vkWaitForFences(m_Context.Device, 1, &m_Context.Frames[i].RenderFence, VK_TRUE, UINT64_MAX);
+            vkDestroyFence(m_Context.Device, m_Context.Frames[i].RenderFence, 0);
+            vkDestroySemaphore(m_Context.Device, m_Context.Frames[i].AcquireSemaphore, 0);
+        }
+
+        for (uint32_t i = 0; i < VkContext::MAX_SWAPCHAIN_IMAGES; i++)
+        {
+            vkDestroySemaphore(m_Context.Device, m_Context.SubmitSemaphores[i], 0);
+        }
 
         // Device
         vkDestroyDevice(m_Context.Device, 0);
@@ -517,8 +668,9 @@ namespace ThatEngine
             m_PipelineBindOrder[1] = PipelineType::WorldSpaceText;
         }
 
-        // Update active pipelines
+        // Update active pipelines, culling runs in every mode
         m_PipelineManager.SetActivePipelines(m_PipelineBindOrder);
+        m_PipelineManager.ActivatePipeline(PipelineType::CullMeshInstances);
 
         m_RenderMode = mode;
         THAT_CORE_INFO("Renderer: {}_MODE enabled!", ToString(mode));
@@ -536,27 +688,213 @@ namespace ThatEngine
 
     void Renderer::UploadRenderableDatapackToGPU(VkCommandBuffer& cmd, RenderableDatapack& datapack)
     {
-        VkDeviceSize offset = 0;
+        FrameData& frame = m_Context.GetCurrentFrame();
+        const VkDeviceSize alignment = m_Context.GpuProperties.limits.minStorageBufferOffsetAlignment;
+
+        // Meshes are only drawn once their draw commands made it into this frame's buffer
+        datapack.MeshSlotCount = 0;
+
+        // Mesh draw commands are rewritten every frame, culling appends every visible slot to one of them
+        const VkDeviceSize meshSlotCount = m_MeshInstances.GetSlotCount();
+        const VkDeviceSize meshDrawCommandsSize = meshSlotCount > 0 ? sizeof(VkDrawIndexedIndirectCommand) * MeshInstanceStore::MESH_TYPE_COUNT : 0;
+
         VkDeviceSize totalDataSize = 0;
+        totalDataSize = AlignInstanceOffset(totalDataSize, alignment) + GetInstanceBatchesSize(datapack.WorldSpaceGlyphInstanceBatches);
+        totalDataSize = AlignInstanceOffset(totalDataSize, alignment) + GetInstanceBatchesSize(datapack.ScreenSpaceGlyphInstanceBatches);
+        totalDataSize = AlignInstanceOffset(totalDataSize, alignment) + meshDrawCommandsSize;
+
+        // Visible slots are only written by the culling pass, reserved but not uploaded
+        const VkDeviceSize reservedSize = AlignInstanceOffset(totalDataSize, alignment) + sizeof(uint32_t) * meshSlotCount;
+        
+        if (totalDataSize > 0)
+        {
+            // One region for every batch, written straight into mapped memory
+            UploadAllocation upload = {};
+            if (ReserveInstanceBuffer(frame, reservedSize))
+            {
+                upload = m_Resources->GetBufferManager().AllocateUpload(totalDataSize);
+            }
+
+            if (!upload.Data)
+            {
+                // Nothing to draw from, skip instances for this frame
+                datapack.WorldSpaceGlyphInstanceBatches.clear();
+                datapack.ScreenSpaceGlyphInstanceBatches.clear();
+                datapack.WorldSpaceGlyphInstanceBatchesOffset = 0;
+                datapack.ScreenSpaceGlyphInstanceBatchesOffset = 0;
+            }
+
+            else
+            {
+                std::byte* destination = static_cast<std::byte*>(upload.Data);
+                VkDeviceSize offset = 0;
 
-        UploadInstanceBatches<MeshAssetType, MeshInstance>(cmd, datapack.MeshInstanceBatches, totalDataSize, datapack.MeshInstanceBatchesOffset, offset);
-        UploadInstanceBatches<FontAssetType, GlyphInstance>(cmd, datapack.WorldSpaceGlyphInstanceBatches, totalDataSize, datapack.WorldSpaceGlyphInstanceBatchesOffset, offset);
-        UploadInstanceBatches<FontAssetType, GlyphInstance>(cmd, datapack.ScreenSpaceGlyphInstanceBatches, totalDataSize, datapack.ScreenSpaceGlyphInstanceBatchesOffset, offset);
-        m_Resources->GetBufferManager().CopyData(cmd, m_Context.InstanceStagingBuffer, m_Context.InstanceBuffer, totalDataSize, 0, 0);
+                UploadInstanceBatches<FontAssetType, GlyphInstance>(destination, datapack.WorldSpaceGlyphInstanceBatches, datapack.WorldSpaceGlyphInstanceBatchesOffset, offset, alignment);
+                UploadInstanceBatches<FontAssetType, GlyphInstance>(destination, datapack.ScreenSpaceGlyphInstanceBatches, datapack.ScreenSpaceGlyphInstanceBatchesOffset, offset, alignment);
+
+                if (meshSlotCount > 0)
+                {
+                    UploadMeshDrawCommands(destination, datapack, offset, alignment);
+                }
+
+                m_Resources->GetBufferManager().CopyData(cmd, upload, frame.InstanceBuffer);
+
+                // Copy has to land before culling updates the draw commands and vertex shaders read the instances
+                VkBufferMemoryBarrier barrier = {};
+                barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.buffer = frame.InstanceBuffer.Buffer;
+                barrier.offset = 0;
+                barrier.size = totalDataSize;
+                vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+            }
+        }
+
+        // Bind this frame's instance buffer, it may have been reallocated, offsets select each section
+        for (PipelineType type : { PipelineType::WorldSpaceText, PipelineType::WorldSpaceTextWireframe, PipelineType::ScreenSpaceText })
+        {
+            m_PipelineManager.BindBufferResource(type, 1, frame.InstanceBuffer);
+        }
 
-        // Update buffer offsets
         m_PipelineManager.UpdatePipelineBoundBufferOffset(m_PipelineBindOrder[1], 1, datapack.WorldSpaceGlyphInstanceBatchesOffset);
         m_PipelineManager.UpdatePipelineBoundBufferOffset(PipelineType::ScreenSpaceText, 1, datapack.ScreenSpaceGlyphInstanceBatchesOffset);
+
+        // Meshes read resident instances through the visible slots culling wrote into this frame's buffer
+        for (PipelineType type : { PipelineType::DefaultLit, PipelineType::DefaultLitWireframe })
+        {
+            m_PipelineManager.BindBufferResource(type, 1, m_MeshInstances.GetInstanceBuffer());
+            m_PipelineManager.BindBufferResource(type, 3, frame.InstanceBuffer, datapack.VisibleMeshInstancesOffset);
+        }
+
+        m_PipelineManager.BindBufferResource(PipelineType::CullMeshInstances, 0, m_MeshInstances.GetBoundsBuffer());
+        m_PipelineManager.BindBufferResource(PipelineType::CullMeshInstances, 1, frame.InstanceBuffer, datapack.MeshDrawCommandsOffset);
+        m_PipelineManager.BindBufferResource(PipelineType::CullMeshInstances, 2, frame.InstanceBuffer, datapack.VisibleMeshInstancesOffset);
+    }
+
+    // Every mesh type has the draw command at its own index, the draw index of its slots
+    void Renderer::UploadMeshDrawCommands(std::byte* destination, RenderableDatapack& datapack, VkDeviceSize& offset, VkDeviceSize alignment)
+    {
+        offset = AlignInstanceOffset(offset, alignment);
+        datapack.MeshDrawCommandsOffset = offset;
+
+        // Regions of visible slots are as large as the number of instances of their type
+        VkDrawIndexedIndirectCommand* commands = reinterpret_cast<VkDrawIndexedIndirectCommand*>(destination + offset);
+        uint32_t firstInstance = 0;
+
+        for (uint32_t i = 0; i < MeshInstanceStore::MESH_TYPE_COUNT; i++)
+        {
+            const MeshAssetType type = static_cast<MeshAssetType>(i);
+            const uint32_t instanceCount = m_MeshInstances.GetInstanceCount(type);
+
+            VkDrawIndexedIndirectCommand command = {};
+            command.indexCount = instanceCount > 0 ? m_Resources->GetMeshManager().GetMeshAssetGPUData(type).IndexCount : 0;
+            command.instanceCount = 0;
+            command.firstIndex = 0;
+            command.vertexOffset = 0;
+            command.firstInstance = firstInstance;
+            commands[i] = command;
+
+            firstInstance += instanceCount;
+        }
+
+        offset += sizeof(VkDrawIndexedIndirectCommand) * MeshInstanceStore::MESH_TYPE_COUNT;
+
+        // Visible slots, only reserved
+        datapack.VisibleMeshInstancesOffset = AlignInstanceOffset(offset, alignment);
+        // Slots that never made it to the buffers hold garbage, a failed upload leaves them out until it succeeds
+        datapack.MeshSlotCount = m_MeshInstances.GetResidentSlotCount();
+    }
+
+    void Renderer::CullMeshInstances(const VkCommandBuffer& cmd, const RenderableDatapack& datapack)
+    {
+        if (datapack.MeshSlotCount == 0) return;
+
+        MeshCullingData cullingData = {};
+        cullingData.InstanceCount = datapack.MeshSlotCount;
+        cullingData.DrawCount = MeshInstanceStore::MESH_TYPE_COUNT;
+
+        Utils::Geometry::Plane frustumPlanes[6];
+        Utils::Geometry::ExtractFrustumPlanes(m_GlobalData.PerspectiveViewProjection, frustumPlanes);
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            cullingData.FrustumPlanes[i] = glm::vec4(frustumPlanes[i].Normal, frustumPlanes[i].Distance);
+        }
+
+        m_PipelineManager.BindPipeline(cmd, PipelineType::CullMeshInstances);
+        vkCmdPushConstants(cmd, m_PipelineManager.GetPipelineLayout(PipelineType::CullMeshInstances), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshCullingData), &cullingData);
+        vkCmdDispatch(cmd, (datapack.MeshSlotCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+        // Draw commands and visible instances have to be complete before the mesh draws read them
+        VkBufferMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = m_Context.GetCurrentFrame().InstanceBuffer.Buffer;
+        barrier.offset = datapack.MeshDrawCommandsOffset;
+        barrier.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    // Grows geometrically, the frame's fence has signaled so its previous buffer is no longer in use
+    bool Renderer::ReserveInstanceBuffer(FrameData& frame, VkDeviceSize size)
+    {
+        if (size <= frame.InstanceBuffer.Size) 
+        {
+            m_IsInstanceOverflowReported = false;
+            return true;
+        }
+
+        const VkDeviceSize maxSize = m_Context.GpuProperties.limits.maxStorageBufferRange;
+        if (size > maxSize)
+        {
+            // Reported once per overflow, not every frame
+            if (!m_IsInstanceOverflowReported)
+            {
+                THAT_CORE_ERROR("Renderer: Instance data of {:.2f} MB exceeds the {:.2f} MB storage buffer limit, instances are not drawn!", 
+                    static_cast<float>(size) / SIZE_MB(1), static_cast<float>(maxSize) / SIZE_MB(1));
+                m_IsInstanceOverflowReported = true;
+            }
+
+            return false;
+        }
+
+        VkDeviceSize capacity = glm::min(glm::max(size, static_cast<VkDeviceSize>(frame.InstanceBuffer.Size) * 2), maxSize);
+
+        m_Resources->GetBufferManager().DestroyBuffer(frame.InstanceBuffer);
+        frame.InstanceBuffer = m_Resources->GetBufferManager().AllocateBuffer(
+            static_cast<uint32_t>(capacity),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+
+        THAT_CORE_INFO("Renderer: Instance buffer of frame {} grew to {:.2f} MB", m_Context.CurrentFrame, static_cast<float>(capacity) / SIZE_MB(1));
+
+        return true;
     }
 
+    // Only stored here, it is written into the frame's mapped uniform buffer while recording
     void Renderer::UploadGlobalData(const GlobalData& globalData)
     {
-        VkCommandBuffer cmd = VulkanUtils::BeginSingleTimeCommands(m_Context.Device, m_Context.CommandPool);
+        m_GlobalData = globalData;
+    }
+
+    void Renderer::BindFrameResources(FrameData& frame)
+    {
+        // Frame fence has signaled, so nothing on the GPU reads this copy anymore
+        memcpy(frame.GlobalDataBuffer.Data, &m_GlobalData, sizeof(GlobalData));
 
-        m_Resources->GetBufferManager().UploadData(m_Context.GlobalDataStagingBuffer, &globalData, m_Context.GlobalDataBuffer.Size, 0);
-        m_Resources->GetBufferManager().CopyData(cmd, m_Context.GlobalDataStagingBuffer, m_Context.GlobalDataBuffer, m_Context.GlobalDataBuffer.Size, 0, 0);
+        for (PipelineType type : { PipelineType::DefaultLit, PipelineType::DefaultLitWireframe, PipelineType::WorldSpaceText, PipelineType::WorldSpaceTextWireframe, PipelineType::ScreenSpaceText })
+        {
+            m_PipelineManager.BindBufferResource(type, 0, frame.GlobalDataBuffer);
+        }
 
-        VulkanUtils::EndSingleTimeCommands(m_Context.Device, m_Context.GraphicsQueue, m_Context.CommandPool, cmd);
+        m_PipelineManager.BindBufferResource(PipelineType::PostProcessing, 0, frame.GlobalDataBuffer);
     }
 
     void Renderer::UpdateViewport(const VkCommandBuffer& cmd)
@@ -567,6 +905,8 @@ namespace ThatEngine
 
     bool Renderer::Render(RenderableDatapack& datapack)
     {
+        ScopedAllocationTag allocationTag(AllocationTag::Renderer);
+
         if (m_Window->IsMinimized())
         {
             return false;
@@ -591,41 +931,107 @@ namespace ThatEngine
 
     bool Renderer::BeginFrame()
     {   
-        VK_CHECK(vkWaitForFences(m_Context.Device, 1, &m_Context.ImageAvailableFence, VK_TRUE, UINT64_MAX));
-        VK_CHECK(vkResetFences(m_Context.Device, 1, &m_Context.ImageAvailableFence));
-        VkResult result = vkAcquireNextImageKHR(m_Context.Device, m_Context.Swapchain, UINT64_MAX, m_Context.AcquireSemaphore, 0, &m_CurrentImageId);
-        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+        FrameData& frame = m_Context.GetCurrentFrame();
+
+        // Only waits for the GPU when it is a full FramesInFlight behind
+        VK_CHECK(vkWaitForFences(m_Context.Device, 1, &frame.RenderFence, VK_TRUE, UINT64_MAX));
+        ReadbackFrame(frame);
+
+        // Results of the frame that last used this slot are complete once its fence is signaled
+        if (m_GpuProfiler.Collect(m_Context.CurrentFrame))
         {
-            m_RecreateSwapchain = true;
-            return false;
-        }  
-        
-        VK_CHECK(vkResetCommandBuffer(m_Context.CommandBuffer, 0));
+            m_StatsTracker->SetGpuTime(m_GpuProfiler.GetFrameTime());
+            m_StatsTracker->SetGpuRegionTimes(m_GpuProfiler.GetRegionTimes());
+
+            if (m_GpuProfiler.IsCollectingPipelineStatistics())
+            {
+                const GpuPipelineStatistics& statistics = m_GpuProfiler.GetPipelineStatistics();
+                m_StatsTracker->SetGpuPipelineStatistics(statistics);
+
+                TracyPlot("GPU Vertex Invocations", static_cast<int64_t>(statistics.VertexShaderInvocations));
+                TracyPlot("GPU Fragment Invocations", static_cast<int64_t>(statistics.FragmentShaderInvocations));
+                TracyPlot("GPU Clipping Primitives", static_cast<int64_t>(statistics.ClippingPrimitives));
+            }
+        }
+
+        m_Resources->GetBufferManager().BeginUploadFrame(m_Context.CurrentFrame);
+
+        // Offscreen images are used in order, there is nothing to acquire them from
+        if (m_Properties.IsHeadless)
+        {
+            m_CurrentImageId = (m_CurrentImageId + 1) % m_Context.SwapchainImageCount;
+        }
+
+        else
+        {
+            VkResult result = vkAcquireNextImageKHR(m_Context.Device, m_Context.Swapchain, UINT64_MAX, frame.AcquireSemaphore, 0, &m_CurrentImageId);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR)
+            {
+                m_RecreateSwapchain = true;
+                return false;
+            }
+        }
+
+        // Per-image attachments may still be used by another frame in flight
+        VkFence& imageFence = m_Context.ImageFences[m_CurrentImageId];
+        if (imageFence != VK_NULL_HANDLE && imageFence != frame.RenderFence)
+        {
+            VK_CHECK(vkWaitForFences(m_Context.Device, 1, &imageFence, VK_TRUE, UINT64_MAX));
+        }
+
+        imageFence = frame.RenderFence;
+        m_PipelineManager.SetCurrentImage(m_CurrentImageId);
+
+        // Reset only once work is guaranteed to be submitted, otherwise the next wait never returns
+        VK_CHECK(vkResetFences(m_Context.Device, 1, &frame.RenderFence));
+        VK_CHECK(vkResetCommandBuffer(frame.CommandBuffer, 0));
+
+        // Secondary command buffers are recorded again every frame
+        for (SecondaryCommandPool& pool : frame.SecondaryCommandPools)
+        {
+            VK_CHECK(vkResetCommandPool(m_Context.Device, pool.Pool, 0));
+            pool.UsedCount = 0;
+        }
         
         return true;
     }
 
     void Renderer::RecordCommands(RenderableDatapack& datapack)
     {
-        VkCommandBuffer cmd = m_Context.CommandBuffer;
+        VkCommandBuffer cmd = m_Context.GetCurrentFrame().CommandBuffer;
         VkCommandBufferBeginInfo info = VulkanUtils::CreateCommandBufferBeginInfo();
         VK_CHECK(vkBeginCommandBuffer(cmd, &info));
 
-        m_GpuTimer.StartTimestamp(m_Context.CommandBuffer);
+        // Opens the frame region, closed in EndFrame
+        m_GpuProfiler.BeginFrame(cmd, m_Context.CurrentFrame);
 
-        // Upload datapack to GPU
+        // Upload global data, changed mesh instances and datapack to GPU, the datapack upload binds the instance buffers
         {
+            GpuProfileScope profileScope(m_GpuProfiler, cmd, "Upload");
+            BindFrameResources(m_Context.GetCurrentFrame());
+            m_MeshInstances.Upload(cmd);
             UploadRenderableDatapackToGPU(cmd, datapack);
+
+            TracyPlot("Uploaded Mesh Slots", static_cast<int64_t>(m_MeshInstances.GetUploadedSlotCount()));
+            TracyPlot("Uploaded Mesh Ranges", static_cast<int64_t>(m_MeshInstances.GetUploadedRangeCount()));
         }
 
-        // Set active pipelines and update their descriptor sets before starting render pass
+        // Write descriptors that changed before starting render pass
         {
-            m_PipelineManager.BindInputAttachmentResource(PipelineType::PostProcessing, 3, m_Context.GeometryColorImages[m_CurrentImageId], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            m_PipelineManager.BindInputAttachmentResource(PipelineType::PostProcessing, 4, m_Context.DepthImages[m_CurrentImageId], VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL);
-
             m_PipelineManager.UpdateDescriptorSets();
         }
 
+        // Mesh culling fills the indirect draw commands, has to run outside of the render pass
+        {
+            GpuProfileScope profileScope(m_GpuProfiler, cmd, "Mesh Culling");
+            CullMeshInstances(cmd, datapack);
+        }
+
+        // Subpass 0 only allows executing secondary command buffers, so the geometry region begins before the render pass
+        // and ends in subpass 1
+        std::optional<GpuProfileScope> geometryProfileScope;
+        geometryProfileScope.emplace(m_GpuProfiler, cmd, "Geometry");
+
         // Begin render pass
         {
             std::array<VkClearValue, 2> clearValues = {};
@@ -639,97 +1045,256 @@ namespace ThatEngine
             info.framebuffer = m_Context.Framebuffers[m_CurrentImageId];
             info.pClearValues = clearValues.data();
             info.clearValueCount = clearValues.size();
-            vkCmdBeginRenderPass(cmd, &info, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdBeginRenderPass(cmd, &info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
         }
 
-        // Subpass 0: Geometry with text
+        // Subpass 0: Geometry with text, recorded in parallel into secondary command buffers
         {
+            RecordGeometrySubpass(cmd, datapack);
+        }
+
+        vkCmdNextSubpass(cmd, VK_SUBPASS_CONTENTS_INLINE);
+        geometryProfileScope.reset();
+
+        // Subpass 1: Post-processing
+        {
+            GpuProfileScope profileScope(m_GpuProfiler, cmd, "Post-Processing");
             UpdateViewport(cmd);
+            m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[3]);
+
+            // Screen quad is baked into the shader
+            vkCmdDraw(cmd, 6, 1, 0, 0);
+        }
+    }
 
-            // Default lit pipeline
-            m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[0]);
+    void Renderer::RecordGeometrySubpass(const VkCommandBuffer& cmd, const RenderableDatapack& datapack)
+    {
+        // Execution order has to match the order they were recorded in before, text is blended over meshes
+        std::array<VkCommandBuffer, 3> secondaries = {};
 
-            // Meshes
-            for (const auto& [mesh, batch] : datapack.MeshInstanceBatches)
+        // Job threads do not know the calling thread's profiler region, so text regions get it passed
+        const uint32_t geometryRegion = GpuProfileScope::GetCurrentRegion();
+
+        JobCounter counter;
+        m_Jobs->Run([this, &secondaries, &datapack, geometryRegion]()
+        {
+            secondaries[1] = BeginSecondaryCommandBuffer(0);
             {
-                if (batch.Instances.empty()) continue;
-                
-                VkDeviceSize offset = 0;
-                // Bind vertex and index data for the current mesh
-                const MeshGPUData& meshGpuData = m_Resources->GetMeshManager().GetMeshAssetGPUData(mesh);
-                vkCmdBindVertexBuffers(cmd, 0, 1, &meshGpuData.VertexBuffer.Buffer, &offset);
-                vkCmdBindIndexBuffer(cmd, meshGpuData.IndexBuffer.Buffer, offset, VK_INDEX_TYPE_UINT32);
+                GpuProfileScope profileScope(m_GpuProfiler, secondaries[1], "World Text", geometryRegion);
+                RecordGlyphs(secondaries[1], m_PipelineBindOrder[1], datapack.WorldSpaceGlyphInstanceBatches);
+            }
+            VK_CHECK(vkEndCommandBuffer(secondaries[1]));
+        }, counter);
+
+        m_Jobs->Run([this, &secondaries, &datapack, geometryRegion]()
+        {
+            secondaries[2] = BeginSecondaryCommandBuffer(0);
+            {
+                GpuProfileScope profileScope(m_GpuProfiler, secondaries[2], "Screen Text", geometryRegion);
+                RecordGlyphs(secondaries[2], m_PipelineBindOrder[2], datapack.ScreenSpaceGlyphInstanceBatches);
+            }
+            VK_CHECK(vkEndCommandBuffer(secondaries[2]));
+        }, counter);
 
-                // One draw call per mesh type
-                vkCmdDrawIndexed(cmd, meshGpuData.IndexCount, static_cast<uint32_t>(batch.Instances.size()), 0, 0, batch.FirstInstance);
+        // Calling thread records meshes meanwhile
+        {
+            secondaries[0] = BeginSecondaryCommandBuffer(0);
+            {
+                GpuProfileScope profileScope(m_GpuProfiler, secondaries[0], "Meshes");
+                RecordMeshes(secondaries[0], datapack);
             }
+            VK_CHECK(vkEndCommandBuffer(secondaries[0]));
+        }
+
+        m_Jobs->Wait(counter);
+
+        vkCmdExecuteCommands(cmd, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+    }
+
+    // Picks a command buffer from the calling thread's pool of the current frame
+    VkCommandBuffer Renderer::BeginSecondaryCommandBuffer(uint32_t subpass)
+    {
+        const uint32_t threadIndex = JobManager::GetCurrentThreadIndex();
+        THAT_CORE_ASSERT(threadIndex != INVALID_UINT32_ID, "Renderer: Secondary command buffers can only be recorded by job threads!", 0);
+
+        SecondaryCommandPool& pool = m_Context.GetCurrentFrame().SecondaryCommandPools[threadIndex];
+        if (pool.UsedCount == pool.CommandBuffers.size())
+        {
+            VkCommandBufferAllocateInfo allocInfo = VulkanUtils::CreateCommandBufferAllocateInfo(pool.Pool);
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+            VkCommandBuffer commandBuffer;
+            VK_CHECK(vkAllocateCommandBuffers(m_Context.Device, &allocInfo, &commandBuffer));
+            pool.CommandBuffers.push_back(commandBuffer);
+        }
+
+        VkCommandBuffer cmd = pool.CommandBuffers[pool.UsedCount++];
+
+        VkCommandBufferInheritanceInfo inheritanceInfo = {};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = m_Context.RenderPass;
+        inheritanceInfo.subpass = subpass;
+        inheritanceInfo.framebuffer = m_Context.Framebuffers[m_CurrentImageId];
+        inheritanceInfo.pipelineStatistics = m_GpuProfiler.GetInheritedPipelineStatistics();
+
+        VkCommandBufferBeginInfo info = VulkanUtils::CreateCommandBufferBeginInfo();
+        info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        info.pInheritanceInfo = &inheritanceInfo;
+        VK_CHECK(vkBeginCommandBuffer(cmd, &info));
+
+        // Dynamic state is not inherited from the primary command buffer
+        UpdateViewport(cmd);
 
-            // Prepare quad mesh for text rendering
+        return cmd;
+    }
+
+    void Renderer::RecordMeshes(const VkCommandBuffer& cmd, const RenderableDatapack& datapack)
+    {
+        // Default lit pipeline
+        m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[0]);
+
+        // Meshes, one indirect draw per mesh type, instance count comes from culling
+        for (uint32_t i = 0; i < MeshInstanceStore::MESH_TYPE_COUNT && datapack.MeshSlotCount > 0; i++)
+        {
+            const MeshAssetType type = static_cast<MeshAssetType>(i);
+            if (m_MeshInstances.GetInstanceCount(type) == 0) continue;
+            
             VkDeviceSize offset = 0;
-            const MeshGPUData& quadMeshData = m_Resources->GetMeshManager().GetMeshAssetGPUData(MeshAssetType::Quad);
-            vkCmdBindVertexBuffers(cmd, 0, 1, &quadMeshData.VertexBuffer.Buffer, &offset);
-            vkCmdBindIndexBuffer(cmd, quadMeshData.IndexBuffer.Buffer, offset, VK_INDEX_TYPE_UINT32);
+            // Bind vertex and index data for the current mesh
+            const MeshGPUData& meshGpuData = m_Resources->GetMeshManager().GetMeshAssetGPUData(type);
+            vkCmdBindVertexBuffers(cmd, 0, 1, &meshGpuData.VertexBuffer.Buffer, &offset);
+            vkCmdBindIndexBuffer(cmd, meshGpuData.IndexBuffer.Buffer, offset, VK_INDEX_TYPE_UINT32);
 
-            // World space text pipeline
-            m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[1]);
+            VkDeviceSize commandOffset = datapack.MeshDrawCommandsOffset + sizeof(VkDrawIndexedIndirectCommand) * i;
+            vkCmdDrawIndexedIndirect(cmd, m_Context.GetCurrentFrame().InstanceBuffer.Buffer, commandOffset, 1, sizeof(VkDrawIndexedIndirectCommand));
+        }
+    }
 
-            for (const auto& [font, batch] : datapack.WorldSpaceGlyphInstanceBatches)
-            {
-                if (batch.Instances.empty()) continue;
-                
-                vkCmdDrawIndexed(cmd, quadMeshData.IndexCount, static_cast<uint32_t>(batch.Instances.size()), 0, 0, batch.FirstInstance);
-            }     
+    void Renderer::RecordGlyphs(const VkCommandBuffer& cmd, PipelineType pipeline, const InstanceBatchMap<FontAssetType, GlyphInstance>& batches)
+    {
+        m_PipelineManager.BindPipeline(cmd, pipeline);
+
+        // Glyphs are instanced quads
+        VkDeviceSize offset = 0;
+        const MeshGPUData& quadMeshData = m_Resources->GetMeshManager().GetMeshAssetGPUData(MeshAssetType::Quad);
+        vkCmdBindVertexBuffers(cmd, 0, 1, &quadMeshData.VertexBuffer.Buffer, &offset);
+        vkCmdBindIndexBuffer(cmd, quadMeshData.IndexBuffer.Buffer, offset, VK_INDEX_TYPE_UINT32);
+
+        for (const auto& [font, batch] : batches)
+        {
+            if (batch.Instances.empty()) continue;
             
-            // Screen space text pipeline
-            m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[2]);
+            vkCmdDrawIndexed(cmd, quadMeshData.IndexCount, static_cast<uint32_t>(batch.Instances.size()), 0, 0, batch.FirstInstance);
+        }
+    }
+
+    // Copies the final image of the frame to its readback buffer, checksummed once the frame's fence is signaled
+    void Renderer::RecordReadback(const VkCommandBuffer& cmd)
+    {
+        FrameData& frame = m_Context.GetCurrentFrame();
+
+        // Render pass leaves the image in transfer source layout, its external dependency orders the copy
+        VkBufferImageCopy region = {};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { m_Context.ScreenSize.width, m_Context.ScreenSize.height, 1 };
+        vkCmdCopyImageToBuffer(cmd, m_Context.SwapchainImages[m_CurrentImageId]->Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, frame.ReadbackBuffer.Buffer, 1, &region);
+
+        VkMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        frame.IsReadbackPending = true;
+    }
 
-            for (const auto& [font, batch] : datapack.ScreenSpaceGlyphInstanceBatches)
+    // FNV-1a over 8-byte words of the read back pixels, the frame's fence has to be signaled.
+    // Hashed on a job while the frame is recorded, the buffer is only written again once the frame is submitted
+    void Renderer::ReadbackFrame(FrameData& frame)
+    {
+        if (!frame.IsReadbackPending) return;
+
+        WaitForReadback();
+
+        const std::byte* data = static_cast<const std::byte*>(frame.ReadbackBuffer.Data);
+        const VkDeviceSize size = static_cast<VkDeviceSize>(m_Context.ScreenSize.width) * m_Context.ScreenSize.height * 4;
+
+        m_IsReadbackHashing = true;
+        frame.IsReadbackPending = false;
+
+        m_Jobs->Run([this, data, size]()
+        {
+            uint64_t checksum = FNV_OFFSET_BASIS;
+            VkDeviceSize i = 0;
+            for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
             {
-                if (batch.Instances.empty()) continue;
-                
-                vkCmdDrawIndexed(cmd, quadMeshData.IndexCount, static_cast<uint32_t>(batch.Instances.size()), 0, 0, batch.FirstInstance);
+                uint64_t word;
+                memcpy(&word, data + i, sizeof(uint64_t));
+                checksum = (checksum ^ word) * FNV_PRIME;
             }
-        }
 
-        vkCmdNextSubpass(cmd, VK_SUBPASS_CONTENTS_INLINE);
+            for (; i < size; i++)
+            {
+                checksum = (checksum ^ static_cast<uint64_t>(data[i])) * FNV_PRIME;
+            }
 
-        // Subpass 1: Post-processing
-        {
-            UpdateViewport(cmd);
-            m_PipelineManager.BindPipeline(cmd, m_PipelineBindOrder[3]);
+            m_ReadbackChecksum = checksum;
+        }, m_ReadbackCounter);
+    }
 
-            // Screen quad is baked into the shader
-            vkCmdDraw(cmd, 6, 1, 0, 0);
-        }
+    void Renderer::WaitForReadback()
+    {
+        if (!m_IsReadbackHashing) return;
+
+        m_Jobs->Wait(m_ReadbackCounter);
+        m_FrameChecksums.push_back(m_ReadbackChecksum);
+        m_IsReadbackHashing = false;
     }
 
     void Renderer::EndFrame()
     {
-        VkCommandBuffer cmd = m_Context.CommandBuffer;
+        FrameData& frame = m_Context.GetCurrentFrame();
+        VkCommandBuffer cmd = frame.CommandBuffer;
         vkCmdEndRenderPass(cmd);
-        m_GpuTimer.EndTimestamp(cmd);
+
+        if (m_Properties.IsHeadless && m_Properties.ReadbackFrames)
+        {
+            GpuProfileScope profileScope(m_GpuProfiler, cmd, "Readback");
+            RecordReadback(cmd);
+        }
+
+        m_GpuProfiler.EndFrame(cmd);
         VK_CHECK(vkEndCommandBuffer(cmd));
 
-        // Submit
+        // Submit, offscreen images are not acquired or presented, so there is nothing to wait on or signal
         {
             VkPipelineStageFlags stageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
             VkSubmitInfo info = VulkanUtils::CreateSubmitInfo(&cmd);
-            info.pWaitDstStageMask = &stageMask;
-            info.pWaitSemaphores = &m_Context.AcquireSemaphore;
-            info.waitSemaphoreCount = 1;
-            info.pSignalSemaphores = &m_Context.SubmitSemaphore;
-            info.signalSemaphoreCount = 1;
-            VK_CHECK(vkQueueSubmit(m_Context.GraphicsQueue, 1, &info, m_Context.ImageAvailableFence));
+
+            if (!m_Properties.IsHeadless)
+            {
+                info.pWaitDstStageMask = &stageMask;
+                info.pWaitSemaphores = &frame.AcquireSemaphore;
+                info.waitSemaphoreCount = 1;
+                info.pSignalSemaphores = &m_Context.SubmitSemaphores[m_CurrentImageId];
+                info.signalSemaphoreCount = 1;
+            }
+
+            // The readback buffer being hashed may belong to this frame
+            WaitForReadback();
+            VK_CHECK(vkQueueSubmit(m_Context.GraphicsQueue, 1, &info, frame.RenderFence));
         }
 
         // Present
+        if (!m_Properties.IsHeadless)
         {
             VkPresentInfoKHR info = {};
             info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
             info.pSwapchains = &m_Context.Swapchain;
             info.swapchainCount = 1;
             info.pImageIndices = &m_CurrentImageId;
-            info.pWaitSemaphores = &m_Context.SubmitSemaphore;
+            info.pWaitSemaphores = &m_Context.SubmitSemaphores[m_CurrentImageId];
             info.waitSemaphoreCount = 1;
             VkResult result = vkQueuePresentKHR(m_Context.GraphicsQueue, &info);
 
@@ -739,30 +1304,49 @@ namespace ThatEngine
             }    
         }   
 
-        m_StatsTracker->SetGpuTime(m_GpuTimer.GetElapsedTimeMs());
+        m_Context.CurrentFrame = (m_Context.CurrentFrame + 1) % m_Context.FramesInFlight;
     }
 
     void Renderer::CreateSwapchain()
     {
-        VkSurfaceCapabilitiesKHR capabilities = {};
-        VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_Context.Gpu, m_Context.Surface, &capabilities));            
-        
-        const uint32_t width = capabilities.currentExtent.width;
-        const uint32_t height = capabilities.currentExtent.height;
-
-        VkSwapchainCreateInfoKHR info = {};
-        info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        info.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
-        info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
-        info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        info.surface = m_Context.Surface;
-        info.preTransform = capabilities.currentTransform;
-        info.imageFormat = m_Context.SurfaceFormat.format;
-        info.imageExtent = capabilities.currentExtent;
-        uint32_t minImageCount = capabilities.minImageCount + 1 > capabilities.maxImageCount ? capabilities.minImageCount : capabilities.minImageCount + 1;
-        info.minImageCount = minImageCount;
-        info.imageArrayLayers = 1;
-        VK_CHECK(vkCreateSwapchainKHR(m_Context.Device, &info, 0, &m_Context.Swapchain));
+        uint32_t width = m_Context.ScreenSize.width;
+        uint32_t height = m_Context.ScreenSize.height;
+        std::array<VkImage,VkContext::MAX_SWAPCHAIN_IMAGES> swapchainImageHandles = {};
+        VkImageUsageFlags swapchainImageUsage = 0;
+
+        // Offscreen images stand in for the swapchain, one per frame in flight is enough without presentation
+        if (m_Properties.IsHeadless)
+        {
+            m_Context.Swapchain = VK_NULL_HANDLE;
+            m_Context.SwapchainImageCount = m_Context.FramesInFlight;
+            swapchainImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+
+        else
+        {
+            VkSurfaceCapabilitiesKHR capabilities = {};
+            VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_Context.Gpu, m_Context.Surface, &capabilities));            
+            
+            width = capabilities.currentExtent.width;
+            height = capabilities.currentExtent.height;
+
+            VkSwapchainCreateInfoKHR info = {};
+            info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+            info.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+            info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+            info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+            info.surface = m_Context.Surface;
+            info.preTransform = capabilities.currentTransform;
+            info.imageFormat = m_Context.SurfaceFormat.format;
+            info.imageExtent = capabilities.currentExtent;
+            uint32_t minImageCount = capabilities.minImageCount + 1 > capabilities.maxImageCount ? capabilities.minImageCount : capabilities.minImageCount + 1;
+            info.minImageCount = minImageCount;
+            info.imageArrayLayers = 1;
+            VK_CHECK(vkCreateSwapchainKHR(m_Context.Device, &info, 0, &m_Context.Swapchain));
+
+            VK_CHECK(vkGetSwapchainImagesKHR(m_Context.Device, m_Context.Swapchain, &m_Context.SwapchainImageCount, 0));
+            VK_CHECK(vkGetSwapchainImagesKHR(m_Context.Device, m_Context.Swapchain, &m_Context.SwapchainImageCount, swapchainImageHandles.data())); 
+        }
         
         // Create framebuffers
         {
@@ -772,10 +1356,6 @@ namespace ThatEngine
             info.width = m_Context.ScreenSize.width;
             info.height = m_Context.ScreenSize.height;
             info.layers = 1;
-
-            std::array<VkImage,VkContext::MAX_SWAPCHAIN_IMAGES> swapchainImageHandles;
-            VK_CHECK(vkGetSwapchainImagesKHR(m_Context.Device, m_Context.Swapchain, &m_Context.SwapchainImageCount, 0));
-            VK_CHECK(vkGetSwapchainImagesKHR(m_Context.Device, m_Context.Swapchain, &m_Context.SwapchainImageCount, swapchainImageHandles.data())); 
             
             auto& imageManager = m_Resources->GetImageManager();
 
@@ -789,8 +1369,8 @@ namespace ThatEngine
                 m_Context.DepthImages[i] = imageManager.AllocateImage(width, height, 1, m_Context.DepthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT );        
                 imageManager.CreateImageView(m_Context.DepthImages[i], VK_IMAGE_ASPECT_DEPTH_BIT);
                 
-                // Swapchain images
-                m_Context.SwapchainImages[i] = imageManager.AllocateImage(width, height, 1, m_Context.SurfaceFormat.format, 0, swapchainImageHandles[i]);
+                // Swapchain images, headless ones have no handle and get allocated here
+                m_Context.SwapchainImages[i] = imageManager.AllocateImage(width, height, 1, m_Context.SurfaceFormat.format, swapchainImageUsage, swapchainImageHandles[i]);
                 imageManager.CreateImageView(m_Context.SwapchainImages[i], VK_IMAGE_ASPECT_COLOR_BIT);
 
                 // Framebuffer
@@ -812,11 +1392,24 @@ namespace ThatEngine
         {
             imageManager.DestroyImage(m_Context.GeometryColorImages[i]);
             imageManager.DestroyImage(m_Context.DepthImages[i]);
-            vkDestroyImageView(m_Context.Device, m_Context.SwapchainImages[i]->View, nullptr);
             vkDestroyFramebuffer(m_Context.Device, m_Context.Framebuffers[i], nullptr);
+
+            // Swapchain owns its images, only offscreen ones are destroyed with their memory
+            if (m_Properties.IsHeadless)
+            {
+                imageManager.DestroyImage(m_Context.SwapchainImages[i]);
+            }
+
+            else
+            {
+                vkDestroyImageView(m_Context.Device, m_Context.SwapchainImages[i]->View, nullptr);
+            }
         }
         
-        vkDestroySwapchainKHR(m_Context.Device, m_Context.Swapchain, 0);
+        if (m_Context.Swapchain != VK_NULL_HANDLE)
+        {
+            vkDestroySwapchainKHR(m_Context.Device, m_Context.Swapchain, 0);
+        }
     }
 
     void Renderer::RecreateSwapchain()
@@ -825,6 +1418,20 @@ namespace ThatEngine
 
         DestroySwapchain();
         CreateSwapchain();
+        BindSwapchainAttachments();
+
+        // Image indices of the new swapchain are not related to the old ones
+        std::fill(std::begin(m_Context.ImageFences), std::end(m_Context.ImageFences), VK_NULL_HANDLE);
+    }
+
+    // Post-processing has descriptor sets for every swapchain image, they only change with the swapchain
+    void Renderer::BindSwapchainAttachments()
+    {
+        for (uint32_t i = 0; i < m_Context.SwapchainImageCount; i++)
+        {
+            m_PipelineManager.BindInputAttachmentResource(PipelineType::PostProcessing, 3, m_Context.GeometryColorImages[i], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, i);
+            m_PipelineManager.BindInputAttachmentResource(PipelineType::PostProcessing, 4, m_Context.DepthImages[i], VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, i);
+        }
     }
 
     void Renderer::SetScreenSize(uint32_t width, uint32_t height)
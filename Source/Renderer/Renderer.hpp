@@ -11,24 +11,35 @@
 
 #include "Core/Window.hpp"
 #include "Core/StatsTracker.hpp"
+#include "Core/JobManager.hpp"
 #include "Core/Event/WindowEvent.hpp"
 #include "Renderer/Vulkan.hpp"
 #include "Renderer/ResourceManager.hpp"
 #include "Renderer/PipelineManager.hpp"
-#include "Renderer/GpuTimer.hpp"
+#include "Renderer/GpuProfiler.hpp"
+#include "Renderer/MeshInstanceStore.hpp"
 #include "Types/RendererTypes.hpp"
 
 namespace ThatEngine
 {
     class Renderer
     {
+        public:
+        static constexpr uint32_t INITIAL_INSTANCE_BUFFER_SIZE = SIZE_MB(4);
+        static constexpr uint32_t CULL_GROUP_SIZE = 64; // Has to match local_size_x of CullMeshInstances.comp
+
         public:
         Renderer() = default;
-        bool Init(Window* window, ResourceManager* resources, StatsTracker& statsTracker);
+        bool Init(Window* window, ResourceManager* resources, JobManager* jobs, StatsTracker& statsTracker, const RendererProperties& properties = {});
         bool Shutdown();
         
         inline const VkContext& GetGraphicsContext() const { return m_Context; }
         inline const RenderMode& GetRenderMode() const { return m_RenderMode; }
+        inline MeshInstanceStore& GetMeshInstanceStore() { return m_MeshInstances; }
+        inline bool IsHeadless() const { return m_Properties.IsHeadless; }
+
+        // Checksums of read back frames in submission order, only filled when headless frames are read back
+        inline const std::vector<uint64_t>& GetFrameChecksums() const { return m_FrameChecksums; }
 
         void SetRenderMode(RenderMode mode);
 
@@ -40,43 +51,79 @@ namespace ThatEngine
         
         private:
         bool BeginFrame();
+        void BindFrameResources(FrameData& frame);
+        bool ReserveInstanceBuffer(FrameData& frame, VkDeviceSize size);
+        void UploadMeshDrawCommands(std::byte* destination, RenderableDatapack& datapack, VkDeviceSize& offset, VkDeviceSize alignment);
+        void CullMeshInstances(const VkCommandBuffer& cmd, const RenderableDatapack& datapack);
         void RecordCommands(RenderableDatapack& datapack);
+        void RecordGeometrySubpass(const VkCommandBuffer& cmd, const RenderableDatapack& datapack);
+        VkCommandBuffer BeginSecondaryCommandBuffer(uint32_t subpass);
+        void RecordMeshes(const VkCommandBuffer& cmd, const RenderableDatapack& datapack);
+        void RecordGlyphs(const VkCommandBuffer& cmd, PipelineType pipeline, const InstanceBatchMap<FontAssetType, GlyphInstance>& batches);
+        void RecordReadback(const VkCommandBuffer& cmd);
+        void ReadbackFrame(FrameData& frame);
+        void WaitForReadback();
         void EndFrame();
         void CreateSwapchain();
         void DestroySwapchain();
         void RecreateSwapchain();
+        void BindSwapchainAttachments();
         void SetScreenSize(uint32_t width, uint32_t height);
         void UpdateViewport(const VkCommandBuffer& cmd);
 
         template<typename AssetType, typename InstanceType>
-        void UploadInstanceBatches(VkCommandBuffer& cmd, std::unordered_map<AssetType, InstanceBatch<InstanceType>>& batches, VkDeviceSize& totalDataSize, VkDeviceSize& batchOffset, VkDeviceSize& offset)
+        static VkDeviceSize GetInstanceBatchesSize(const InstanceBatchMap<AssetType, InstanceType>& batches)
         {
+            VkDeviceSize size = 0;
+            for (const auto& [_, batch] : batches)
+            {
+                size += sizeof(InstanceType) * batch.Instances.size();
+            }
+
+            return size;
+        }
+
+        template<typename AssetType, typename InstanceType>
+        void UploadInstanceBatches(std::byte* destination, InstanceBatchMap<AssetType, InstanceType>& batches, VkDeviceSize& batchOffset, VkDeviceSize& offset, VkDeviceSize alignment)
+        {
+            offset = AlignInstanceOffset(offset, alignment);
             batchOffset = offset;
             for (auto& [_, batch] : batches)
             {
                 if (batch.Instances.empty()) continue;
 
                 VkDeviceSize dataSize = sizeof(InstanceType) * batch.Instances.size();
-                m_Resources->GetBufferManager().UploadData(m_Context.InstanceStagingBuffer, batch.Instances.data(), dataSize, offset);
+                memcpy(destination + offset, batch.Instances.data(), dataSize);
                 
                 batch.FirstInstance = static_cast<uint32_t>((offset - batchOffset) / sizeof(InstanceType));
                 
                 offset += dataSize;
-                totalDataSize += dataSize;
             }
         }
         
         private:
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+        static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
         VkContext m_Context;
+        RendererProperties m_Properties;
         Window* m_Window;
         ResourceManager* m_Resources;
+        JobManager* m_Jobs;
         StatsTracker* m_StatsTracker;
         PipelineManager m_PipelineManager;
-        GpuTimer m_GpuTimer;
+        GpuProfiler m_GpuProfiler;
+        MeshInstanceStore m_MeshInstances;
         
         std::array<PipelineType, 4> m_PipelineBindOrder;
         RenderMode m_RenderMode;
+        GlobalData m_GlobalData = {};
+        bool m_IsInstanceOverflowReported = false;
         bool m_RecreateSwapchain;
         uint32_t m_CurrentImageId = 0;
+        std::vector<uint64_t> m_FrameChecksums;
+        JobCounter m_ReadbackCounter;
+        uint64_t m_ReadbackChecksum = 0;
+        bool m_IsReadbackHashing = false;
     };
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Renderer/GraphicsContext.hpp"
+#include "Renderer/DeviceMemoryAllocator.hpp"
 #include "Renderer/BufferManager.hpp"
 #include "Renderer/ImageManager.hpp"
 #include "Renderer/ShaderManager.hpp"
@@ -25,9 +26,10 @@ namespace ThatEngine
         void Init(VkContext* context)
         {
             m_Context = context;
-            m_BufferManager.Init(m_Context);
+            m_Allocator.Init(m_Context);
+            m_BufferManager.Init(m_Context, &m_Allocator);
             m_ShaderManager.Init(m_Context);
-            m_ImageManager.Init(m_Context);
+            m_ImageManager.Init(m_Context, &m_Allocator);
         }
         
         // Managers and their late init functions that need staging buffers
@@ -44,8 +46,10 @@ namespace ThatEngine
             m_MeshManager.Shutdown();
             m_ShaderManager.Shutdown();
             m_FontManager.Shutdown();
+            m_Allocator.Shutdown();
         }
 
+        inline DeviceMemoryAllocator& GetDeviceMemoryAllocator() { return m_Allocator; }
         inline BufferManager& GetBufferManager() { return m_BufferManager; }
         inline ImageManager& GetImageManager() { return m_ImageManager; }
         inline MeshManager& GetMeshManager() { return m_MeshManager; }
@@ -54,6 +58,7 @@ namespace ThatEngine
 
         private:
         VkContext* m_Context;
+        DeviceMemoryAllocator m_Allocator;
         BufferManager m_BufferManager;
         ImageManager m_ImageManager;
         MeshManager m_MeshManager;
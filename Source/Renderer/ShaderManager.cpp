@@ -18,10 +18,13 @@ namespace ThatEngine
 
     void ShaderManager::Shutdown()
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
         for (auto& [stage, shaderModuleMap] : m_ShaderModules)
         {
-            for (auto& [name, shaderModule] : shaderModuleMap)
+            for (auto& [name, shaderModuleFuture] : shaderModuleMap)
             {
+                const Shared<ShaderModule>& shaderModule = shaderModuleFuture.get();
                 if (shaderModule && shaderModule->Handle != VK_NULL_HANDLE)
                 {
                     vkDestroyShaderModule(m_Context->Device, shaderModule->Handle, 0);
@@ -31,9 +34,10 @@ namespace ThatEngine
         }
 
         m_ShaderModules.clear();
+        m_ShaderPrograms.clear();
     }
 
-    const Shared<ShaderProgram>& ShaderManager::CreateProgram(ShaderProgramType type, const std::string& vertexPath, const std::string& fragmentPath)
+    Shared<ShaderProgram> ShaderManager::CreateProgram(ShaderProgramType type, const std::string& vertexPath, const std::string& fragmentPath)
     {
         Shared<ShaderModule> vertexShader = LoadShader(vertexPath, VK_SHADER_STAGE_VERTEX_BIT);
 
@@ -64,137 +68,189 @@ namespace ThatEngine
         VulkanUtils::MergePushConstantRanges(shaderProgram->MergedPushConstantRanges, vertexShader->PushConstantRanges, VK_SHADER_STAGE_VERTEX_BIT);
         VulkanUtils::MergePushConstantRanges(shaderProgram->MergedPushConstantRanges, fragmentShader->PushConstantRanges, VK_SHADER_STAGE_FRAGMENT_BIT);
 
-        m_ShaderPrograms[type] = shaderProgram;
+        return AddProgram(type, shaderProgram);
+    }
+
+    Shared<ShaderProgram> ShaderManager::CreateComputeProgram(ShaderProgramType type, const std::string& computePath)
+    {
+        Shared<ShaderModule> computeShader = LoadShader(computePath, VK_SHADER_STAGE_COMPUTE_BIT);
+
+        if (!computeShader)
+        {
+            THAT_CORE_ERROR("Failed to create or load compute shader: {}", computePath);
+        }
+
+        Shared<ShaderProgram> shaderProgram = CreateShared<ShaderProgram>();
+        shaderProgram->Compute = computeShader;
+
+        // Single stage, nothing to merge with but the layout is built from the merged lists
+        VulkanUtils::MergeDescriptorBindings(shaderProgram->MergedDescriptorBindings, computeShader->DescriptorBindings, VK_SHADER_STAGE_COMPUTE_BIT);
+        std::ranges::sort(shaderProgram->MergedDescriptorBindings, {}, &VkDescriptorSetLayoutBinding::binding);
+        VulkanUtils::MergePushConstantRanges(shaderProgram->MergedPushConstantRanges, computeShader->PushConstantRanges, VK_SHADER_STAGE_COMPUTE_BIT);
+
+        return AddProgram(type, shaderProgram);
+    }
+
+    Shared<ShaderProgram> ShaderManager::GetProgram(ShaderProgramType type)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_ShaderPrograms.at(type);
+    }
 
-        return m_ShaderPrograms[type];
+    // Variants of a pipeline create the same program, the first one to finish is kept
+    Shared<ShaderProgram> ShaderManager::AddProgram(ShaderProgramType type, const Shared<ShaderProgram>& program)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto [iterator, isInserted] = m_ShaderPrograms.try_emplace(type, program);
+
+        return iterator->second;
     }
 
     Shared<ShaderModule> ShaderManager::LoadShader(const std::string& path, VkShaderStageFlagBits stage)
     {
         std::string name = FileReader::GetFileName(path);
-        auto& stageMap = m_ShaderModules[stage];
 
-        // Find cached shader module
+        // Find cached shader module or claim it, only the claiming job loads it
+        std::promise<Shared<ShaderModule>> promise;
+        std::shared_future<Shared<ShaderModule>> shaderModule;
+        bool isClaimed = false;
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto& stageMap = m_ShaderModules[stage];
+
             auto iterator = stageMap.find(name);
             if (iterator != stageMap.end())
             {
-                return iterator->second;
+                shaderModule = iterator->second;
             }
+
+            else
+            {
+                shaderModule = promise.get_future().share();
+                stageMap[name] = shaderModule;
+                isClaimed = true;
+            }
+        }
+
+        if (isClaimed)
+        {
+            promise.set_value(CreateShaderModule(path, stage));
         }
+
+        return shaderModule.get();
+    }
+
+    // Reading, module creation and reflection run without holding the lock
+    Shared<ShaderModule> ShaderManager::CreateShaderModule(const std::string& path, VkShaderStageFlagBits stage)
+    {
+        uint32_t shaderSize = 0;
+        auto shaderData = FileReader::ReadBinaryFile<uint32_t>(path, shaderSize);
+
+        THAT_CORE_ASSERT(shaderData != nullptr, "Failed to load shader: {}", path);
         
-        // Create shader module
+        VkShaderModuleCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = shaderSize;
+        createInfo.pCode = shaderData;
+        
+        VkShaderModule vkShaderModule;
+        VK_CHECK(vkCreateShaderModule(m_Context->Device, &createInfo, nullptr, &vkShaderModule));
+        
+        Shared<ShaderModule> shaderModule = CreateShared<ShaderModule>(
+            ShaderModule 
+            { 
+                .Stage = stage, 
+                .Handle = vkShaderModule
+            }
+        );
+
+        // Reflection
+        SpvReflectShaderModule reflection;
         {
-            uint32_t shaderSize = 0;
-            auto shaderData = FileReader::ReadBinaryFile<uint32_t>(path, shaderSize);
-
-            THAT_CORE_ASSERT(shaderData != nullptr, "Failed to load shader: {}", path);
-            
-            VkShaderModuleCreateInfo createInfo = {};
-            createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-            createInfo.codeSize = shaderSize;
-            createInfo.pCode = shaderData;
-            
-            VkShaderModule vkShaderModule;
-            VK_CHECK(vkCreateShaderModule(m_Context->Device, &createInfo, nullptr, &vkShaderModule));
-            
-            Shared<ShaderModule> shaderModule = CreateShared<ShaderModule>(
-                ShaderModule 
-                { 
-                    .Stage = stage, 
-                    .Handle = vkShaderModule
-                }
-            );
+            SPV_CHECK(spvReflectCreateShaderModule(shaderSize, shaderData, &reflection));
+            delete[] shaderData;
 
-            // Reflection
-            SpvReflectShaderModule reflection;
-            {
-                SPV_CHECK(spvReflectCreateShaderModule(shaderSize, shaderData, &reflection));
-                delete[] shaderData;
+            // Entry point
+            shaderModule->EntryPoint = reflection.entry_point_name;
 
-                // Entry point
-                shaderModule->EntryPoint = reflection.entry_point_name;
+            // Descriptor bindings
+            {
+                uint32_t bindingCount = 0;
+                SPV_CHECK(spvReflectEnumerateDescriptorBindings(&reflection, &bindingCount, nullptr));
+                std::vector<SpvReflectDescriptorBinding*> reflectedBindings(bindingCount);
+                SPV_CHECK(spvReflectEnumerateDescriptorBindings(&reflection, &bindingCount, reflectedBindings.data()));
 
-                // Descriptor bindings
+                for (SpvReflectDescriptorBinding* reflectedBinding : reflectedBindings)
                 {
-                    uint32_t bindingCount = 0;
-                    SPV_CHECK(spvReflectEnumerateDescriptorBindings(&reflection, &bindingCount, nullptr));
-                    std::vector<SpvReflectDescriptorBinding*> reflectedBindings(bindingCount);
-                    SPV_CHECK(spvReflectEnumerateDescriptorBindings(&reflection, &bindingCount, reflectedBindings.data()));
-
-                    for (SpvReflectDescriptorBinding* reflectedBinding : reflectedBindings)
-                    {
-                        VkDescriptorSetLayoutBinding layoutBinding = {};
-                        layoutBinding.binding = reflectedBinding->binding;
-                        layoutBinding.descriptorType = static_cast<VkDescriptorType>(reflectedBinding->descriptor_type);
-                        layoutBinding.descriptorCount = reflectedBinding->count;
-                        layoutBinding.stageFlags = stage;
-
-                        shaderModule->DescriptorBindings.emplace_back(layoutBinding);
-                    }   
-                }
+                    VkDescriptorSetLayoutBinding layoutBinding = {};
+                    layoutBinding.binding = reflectedBinding->binding;
+                    layoutBinding.descriptorType = static_cast<VkDescriptorType>(reflectedBinding->descriptor_type);
+                    layoutBinding.descriptorCount = reflectedBinding->count;
+                    layoutBinding.stageFlags = stage;
+
+                    shaderModule->DescriptorBindings.emplace_back(layoutBinding);
+                }   
+            }
 
-                // Push constants
+            // Push constants
+            {
+                uint32_t pushConstantCount = 0;
+                SPV_CHECK(spvReflectEnumeratePushConstantBlocks(&reflection, &pushConstantCount, nullptr));
+                std::vector<SpvReflectBlockVariable*> reflectedPushConstants(pushConstantCount);
+                SPV_CHECK(spvReflectEnumeratePushConstantBlocks(&reflection, &pushConstantCount, reflectedPushConstants.data()));
+
+                for (SpvReflectBlockVariable* reflectedPushConstant : reflectedPushConstants)
                 {
-                    uint32_t pushConstantCount = 0;
-                    SPV_CHECK(spvReflectEnumeratePushConstantBlocks(&reflection, &pushConstantCount, nullptr));
-                    std::vector<SpvReflectBlockVariable*> reflectedPushConstants(pushConstantCount);
-                    SPV_CHECK(spvReflectEnumeratePushConstantBlocks(&reflection, &pushConstantCount, reflectedPushConstants.data()));
-
-                    for (SpvReflectBlockVariable* reflectedPushConstant : reflectedPushConstants)
-                    {
-                        VkPushConstantRange range = {};
-                        range.offset = reflectedPushConstant->offset;
-                        range.size = reflectedPushConstant->size;
-                        range.stageFlags = stage;
-
-                        shaderModule->PushConstantRanges.emplace_back(range);
-                    }
+                    VkPushConstantRange range = {};
+                    range.offset = reflectedPushConstant->offset;
+                    range.size = reflectedPushConstant->size;
+                    range.stageFlags = stage;
+
+                    shaderModule->PushConstantRanges.emplace_back(range);
                 }
+            }
+
+            // Vertex inputs
+            if (stage == VK_SHADER_STAGE_VERTEX_BIT)
+            {
+                uint32_t inputCount = 0;
+                SPV_CHECK(spvReflectEnumerateInputVariables(&reflection, &inputCount, nullptr));
+                std::vector<SpvReflectInterfaceVariable*> reflectedInputs(inputCount);
+                SPV_CHECK(spvReflectEnumerateInputVariables(&reflection, &inputCount, reflectedInputs.data()));
+
+                // Sort inputs by location
+                std::ranges::sort(reflectedInputs, {}, &SpvReflectInterfaceVariable::location);
 
-                // Vertex inputs
-                if (stage == VK_SHADER_STAGE_VERTEX_BIT)
+                uint32_t offset = 0;
+                for (SpvReflectInterfaceVariable* reflectedInput : reflectedInputs)
                 {
-                    uint32_t inputCount = 0;
-                    SPV_CHECK(spvReflectEnumerateInputVariables(&reflection, &inputCount, nullptr));
-                    std::vector<SpvReflectInterfaceVariable*> reflectedInputs(inputCount);
-                    SPV_CHECK(spvReflectEnumerateInputVariables(&reflection, &inputCount, reflectedInputs.data()));
-
-                    // Sort inputs by location
-                    std::ranges::sort(reflectedInputs, {}, &SpvReflectInterfaceVariable::location);
-
-                    uint32_t offset = 0;
-                    for (SpvReflectInterfaceVariable* reflectedInput : reflectedInputs)
-                    {
-                        if (reflectedInput->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) continue;
-
-                        VkFormat format = static_cast<VkFormat>(reflectedInput->format);
-                        uint32_t formatSize = VulkanUtils::GetFormatSize(format);
-
-                        VkVertexInputAttributeDescription attribute = {};
-                        attribute.location = reflectedInput->location;
-                        attribute.binding = 0;
-                        attribute.format = format;
-                        attribute.offset = offset;
-
-                        shaderModule->VertexAttributeDescriptions.emplace_back(attribute);
-                        offset += formatSize;
-                    }
-
-                    VkVertexInputBindingDescription vertexBinding = {};
-                    vertexBinding.binding = 0;
-                    vertexBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-                    vertexBinding.stride = offset;
-                    shaderModule->VertexBindingDescriptions.emplace_back(vertexBinding);
+                    if (reflectedInput->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) continue;
+
+                    VkFormat format = static_cast<VkFormat>(reflectedInput->format);
+                    uint32_t formatSize = VulkanUtils::GetFormatSize(format);
+
+                    VkVertexInputAttributeDescription attribute = {};
+                    attribute.location = reflectedInput->location;
+                    attribute.binding = 0;
+                    attribute.format = format;
+                    attribute.offset = offset;
+
+                    shaderModule->VertexAttributeDescriptions.emplace_back(attribute);
+                    offset += formatSize;
                 }
 
-                spvReflectDestroyShaderModule(&reflection);
+                VkVertexInputBindingDescription vertexBinding = {};
+                vertexBinding.binding = 0;
+                vertexBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+                vertexBinding.stride = offset;
+                shaderModule->VertexBindingDescriptions.emplace_back(vertexBinding);
             }
 
-            THAT_CORE_INFO("Shader Manager: Loading Asset \"{}\"", path);
-
-            stageMap[name] = shaderModule;
-            return shaderModule;
+            spvReflectDestroyShaderModule(&reflection);
         }
+
+        THAT_CORE_INFO("Shader Manager: Loading Asset \"{}\"", path);
+
+        return shaderModule;
     }
 }
\ No newline at end of file
@@ -45,7 +45,7 @@ namespace ThatEngine
         if (result != SPV_REFLECT_RESULT_SUCCESS)                                           \
         {                                                                                   \
             THAT_CORE_ERROR("SPIRV Reflect Error: {}", string_SpvReflectResult(result));    \
-            __debugbreak();                                                                 \
+            DEBUG_BREAK();                                                                  \
         }                                                                                   \
     }                                                                                       \
     while(0)
@@ -58,13 +58,22 @@ namespace ThatEngine
         void Init(VkContext* context);
         void Shutdown();
 
-        const Shared<ShaderProgram>& CreateProgram(ShaderProgramType type, const std::string& vertexPath, const std::string& fragmentPath);
-        inline const Shared<ShaderProgram>& GetProgram(ShaderProgramType type) const { return m_ShaderPrograms.at(type); }
+        // Thread-safe, programs and their shader modules can be created from several jobs at once
+        Shared<ShaderProgram> CreateProgram(ShaderProgramType type, const std::string& vertexPath, const std::string& fragmentPath);
+        Shared<ShaderProgram> CreateComputeProgram(ShaderProgramType type, const std::string& computePath);
+        Shared<ShaderProgram> GetProgram(ShaderProgramType type);
 
         private:
-        VkContext* m_Context;
         Shared<ShaderModule> LoadShader(const std::string& path, VkShaderStageFlagBits stage);
-        std::unordered_map<VkShaderStageFlagBits, std::unordered_map<std::string, Shared<ShaderModule>>> m_ShaderModules;
+        Shared<ShaderModule> CreateShaderModule(const std::string& path, VkShaderStageFlagBits stage);
+        Shared<ShaderProgram> AddProgram(ShaderProgramType type, const Shared<ShaderProgram>& program);
+
+        private:
+        VkContext* m_Context;
+
+        // Modules are published as futures, a module requested while another job loads it waits for that job
+        std::unordered_map<VkShaderStageFlagBits, std::unordered_map<std::string, std::shared_future<Shared<ShaderModule>>>> m_ShaderModules;
         std::unordered_map<ShaderProgramType, Shared<ShaderProgram>> m_ShaderPrograms;
+        std::mutex m_Mutex;
     };
 }
\ No newline at end of file
@@ -20,7 +20,7 @@ namespace ThatEngine
         if (result != VK_SUCCESS)                                           \
         {                                                                   \
             THAT_CORE_ERROR("Vulkan Error: {}", string_VkResult(result));   \
-            __debugbreak();                                                 \
+            DEBUG_BREAK();                                                  \
         }                                                                   \
     }                                                                       \
     while(0)
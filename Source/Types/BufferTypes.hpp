@@ -9,14 +9,25 @@
 #pragma once
 
 #include "Renderer/Vulkan.hpp"
+#include "Types/DeviceMemoryTypes.hpp"
 
 namespace ThatEngine
 {
     struct Buffer
     {
         VkBuffer Buffer;
-        VkDeviceMemory Memory;
+        DeviceAllocation Allocation;
         uint32_t Size;
+        void* Data; // Mapped for host-visible buffers
+        uint64_t Generation; // Unique per allocation, the driver may hand out a destroyed buffer's handle again
+    };
+
+    // Region of the upload ring, Data points straight into mapped memory
+    struct UploadAllocation
+    {
+        VkBuffer Buffer;
+        VkDeviceSize Offset;
+        VkDeviceSize Size;
         void* Data;
     };
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+//
+// File: DeviceMemoryTypes.hpp
+// Description: Defines device memory allocation structs used by DeviceMemoryAllocator and its users
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Renderer/Vulkan.hpp"
+
+namespace ThatEngine
+{
+    // Buffers and optimal-tiling images are kept in separate blocks so bufferImageGranularity never applies
+    enum class DeviceResourceKind : uint32_t
+    {
+        Linear,
+        Optimal,
+        Count
+    };
+
+    struct DeviceAllocation
+    {
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        VkDeviceSize Offset = 0;
+        VkDeviceSize Size = 0;
+        void* Data = nullptr;                       // Mapped pointer, only for host-visible memory
+        uint32_t PoolIndex = INVALID_UINT32_ID;
+        uint32_t BlockIndex = INVALID_UINT32_ID;    // Invalid for dedicated allocations
+        uint32_t Order = 0;
+    };
+
+    struct DeviceMemoryStats
+    {
+        uint32_t BlockCount;
+        uint32_t DedicatedAllocationCount;
+        uint32_t AllocationCount;
+        VkDeviceSize ReservedBytes;         // Allocated from the driver, blocks and dedicated allocations
+        VkDeviceSize UsedBytes;             // Requested by resources
+        VkDeviceSize InternalWasteBytes;    // Lost to rounding allocations up to their buddy size
+        VkDeviceSize FreeBytes;             // Free space inside blocks
+        VkDeviceSize LargestFreeRange;
+        float Fragmentation;                // 1 - largest free range of each block / free bytes, 0 means free space is contiguous in every block
+    };
+}
@@ -20,5 +20,12 @@ namespace ThatEngine
         using Registry = entt::registry;
         using SystemFunction = std::function<void(ECS::Registry&, Timestep)>;
         const uint32_t MAX_ENTITIES = 65336;
+
+        // Access declarations used when registering systems, components or any other shared data type
+        template<typename... Types>
+        struct Read {};
+
+        template<typename... Types>
+        struct Write {};
     }
 }
\ No newline at end of file
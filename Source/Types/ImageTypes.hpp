@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Renderer/Vulkan.hpp"
+#include "Types/DeviceMemoryTypes.hpp"
 
 namespace ThatEngine
 {
@@ -16,11 +17,12 @@ namespace ThatEngine
     {
         VkImage Image;
         VkImageView View;
-        VkDeviceMemory Memory;
+        DeviceAllocation Allocation;
         VkFormat Format;
         uint32_t Width;
         uint32_t Height;
         uint32_t MipLevels;
+        uint64_t ViewGeneration; // Unique per view, the driver may hand out a destroyed view's handle again
     };
 
     enum class TextureType : uint32_t
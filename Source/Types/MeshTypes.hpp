@@ -19,6 +19,7 @@ namespace ThatEngine
         None = 0,
         Quad,
         Cube,
+        Count
     };
 
     // Raw mesh data loaded from disk or generated
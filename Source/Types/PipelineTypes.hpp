@@ -22,9 +22,19 @@ namespace ThatEngine
         WorldSpaceTextWireframe,
         ScreenSpaceText,
         PostProcessing,
+        CullMeshInstances,
         Count
     };
     
+    // Prefixed to the driver's cache data on disk, VkPipelineCacheHeaderVersionOne does not carry the driver version
+    struct PipelineCacheFileHeader
+    {
+        uint32_t Magic;
+        uint32_t DriverVersion;
+        uint64_t DataSize;
+        uint8_t PipelineCacheUUID[VK_UUID_SIZE];
+    };
+
     struct PipelineCreateInfo
     {
         const std::string& Name;
@@ -39,6 +49,14 @@ namespace ThatEngine
         VkPolygonMode PolygonMode = VK_POLYGON_MODE_FILL;
         bool EnableBlending = true;
         bool EnableDepthTesting = true;
+        bool HasSwapchainImageSets = false;    // One descriptor set per frame in flight and swapchain image, for reading swapchain attachments
+    };
+
+    struct ComputePipelineCreateInfo
+    {
+        const std::string& Name;
+        PipelineType Type;
+        const Shared<ShaderProgram>& Program;
     };
 
     // Used for binding descriptors
@@ -51,14 +69,23 @@ namespace ThatEngine
         DepthInputAttachment
     };
 
+    // What one descriptor set holds for a binding, only written again once it changes
+    struct BoundDescriptor
+    {
+        // Descriptor binding info depending on BoundResourceType
+        VkDescriptorImageInfo ImageInfo = {};
+        VkDescriptorBufferInfo BufferInfo = {};
+        // Generation of the bound buffer or image view, a recreated resource can come back with the same handle
+        uint64_t Generation = 0;
+        bool IsDirty = false;
+    };
+
     struct BoundResource
     {
         BoundResourceType Type;
         VkDescriptorType DescriptorType;
         uint32_t Binding;
-        // Descriptor binding info depending on BoundResourceType
-        VkDescriptorImageInfo ImageInfo;
-        VkDescriptorBufferInfo BufferInfo;
+        std::vector<BoundDescriptor> Descriptors; // One per descriptor set
     };
 
     using BoundResources = std::unordered_map<uint32_t, BoundResource>;
@@ -67,9 +94,11 @@ namespace ThatEngine
     struct PipelineResources
     {
         VkPipeline Pipeline;
+        VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
         VkPipelineLayout Layout;
         VkDescriptorSetLayout DescriptorSetLayout;
-        VkDescriptorSet DescriptorSet;  
+        std::vector<VkDescriptorSet> DescriptorSets; // SetsPerFrame for every frame in flight
+        uint32_t SetsPerFrame = 1;
         BoundResources BoundResources;
     };
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "Types/MeshTypes.hpp"
 #include "Types/ShaderTypes.hpp"
 
+#include <memory_resource>
+
 namespace ThatEngine
 {
     enum class RenderMode : uint32_t
@@ -27,43 +29,65 @@ namespace ThatEngine
     constexpr const char* RenderModeNames[static_cast<uint32_t>(RenderMode::Count)] = { "COLOR", "DEPTH", "NORMALS", "TRIANGLES", "WIREFRAME" };
     inline const char* ToString(RenderMode mode) { return RenderModeNames[static_cast<uint32_t>(mode)]; }
 
+    // Instance data sections have to start at offsets the storage buffer descriptors can use
+    inline VkDeviceSize AlignInstanceOffset(VkDeviceSize offset, VkDeviceSize alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    struct RendererProperties
+    {
+        // Frames the CPU can record ahead of the GPU, clamped to VkContext::MAX_FRAMES_IN_FLIGHT
+        uint32_t FramesInFlight = 2;
+
+        // Renders into offscreen images instead of a swapchain, nothing is presented
+        bool IsHeadless = false;
+
+        // Copies every headless frame to host memory and checksums it, for comparing output between builds
+        bool ReadbackFrames = false;
+
+        // Counts vertices, primitives and shader invocations of every frame, needs pipeline statistics query support
+        bool CollectPipelineStatistics = false;
+    };
+
+    // Allocator-aware so batches created inside a pmr map share its memory resource
     template<typename T>
     struct InstanceBatch
     {
-        std::vector<T> Instances;
-        VkDeviceSize FirstInstance;
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        InstanceBatch(const allocator_type& allocator = {}) : Instances(allocator) {}
+        InstanceBatch(const InstanceBatch& other, const allocator_type& allocator) : Instances(other.Instances, allocator), FirstInstance(other.FirstInstance) {}
+        InstanceBatch(InstanceBatch&& other, const allocator_type& allocator) : Instances(std::move(other.Instances), allocator), FirstInstance(other.FirstInstance) {}
+
+        std::pmr::vector<T> Instances;
+        VkDeviceSize FirstInstance = 0;
     };
 
+    template<typename AssetType, typename InstanceType>
+    using InstanceBatchMap = std::pmr::unordered_map<AssetType, InstanceBatch<InstanceType>>;
+
+    // Rebuilt every frame, all containers allocate from the given memory resource,
+    // mesh instances are not part of it, they stay resident in the renderer's MeshInstanceStore
     struct RenderableDatapack
     {
+        RenderableDatapack(std::pmr::memory_resource* resource) : 
+            WorldSpaceGlyphInstanceBatches(resource), 
+            ScreenSpaceGlyphInstanceBatches(resource) 
+        {
+        }
+
         glm::vec4 ClearColor;
-        
-        std::unordered_map<MeshAssetType, InstanceBatch<MeshInstance>> MeshInstanceBatches;
-        VkDeviceSize MeshInstanceBatchesOffset;
 
-        std::unordered_map<FontAssetType, InstanceBatch<GlyphInstance>> WorldSpaceGlyphInstanceBatches;
-        VkDeviceSize WorldSpaceGlyphInstanceBatchesOffset;
+        // Written by the renderer, mesh instances are culled on the GPU
+        uint32_t MeshSlotCount = 0;
+        VkDeviceSize MeshDrawCommandsOffset = 0;
+        VkDeviceSize VisibleMeshInstancesOffset = 0;
 
-        std::unordered_map<FontAssetType, InstanceBatch<GlyphInstance>> ScreenSpaceGlyphInstanceBatches;
-        VkDeviceSize ScreenSpaceGlyphInstanceBatchesOffset;
+        InstanceBatchMap<FontAssetType, GlyphInstance> WorldSpaceGlyphInstanceBatches;
+        VkDeviceSize WorldSpaceGlyphInstanceBatchesOffset = 0;
 
-        // Clear so it doesn't rebuild hashmaps every frame
-        void Clear()
-        {
-            for (auto& [_, batch] : MeshInstanceBatches) 
-            {
-                batch.Instances.clear();
-            }
-
-            for (auto& [_, batch] : WorldSpaceGlyphInstanceBatches)
-            {
-                batch.Instances.clear();
-            }
-
-            for (auto& [_, batch] : ScreenSpaceGlyphInstanceBatches) 
-            {
-                batch.Instances.clear();
-            }
-        }
+        InstanceBatchMap<FontAssetType, GlyphInstance> ScreenSpaceGlyphInstanceBatches;
+        VkDeviceSize ScreenSpaceGlyphInstanceBatchesOffset = 0;
     };
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ namespace ThatEngine
         WorldSpaceText,
         ScreenSpaceText,
         PostProcessing,
+        CullMeshInstances,
         Count
     };
 
@@ -41,6 +42,7 @@ namespace ThatEngine
     {
         Shared<ShaderModule> Vertex;
         Shared<ShaderModule> Fragment;
+        Shared<ShaderModule> Compute;
 
         std::vector<VkDescriptorSetLayoutBinding> MergedDescriptorBindings;
         std::vector<VkPushConstantRange> MergedPushConstantRanges;
@@ -82,4 +84,20 @@ namespace ThatEngine
         glm::vec4 Rect;
         glm::vec4 Color;
     };
+
+    struct MeshInstanceBounds
+    {
+        glm::vec4 Sphere;                       // 16 bytes - Center xyz, radius w
+        uint32_t DrawIndex;                     // 4 bytes -> aligned to 16 bytes
+        uint32_t _padding0[3];
+    };
+
+    // Push constants of the mesh culling compute shader
+    struct MeshCullingData
+    {
+        glm::vec4 FrustumPlanes[6];             // 96 bytes - Normal xyz, distance w
+        uint32_t InstanceCount;                 // 4 bytes
+        uint32_t DrawCount;                     // 4 bytes -> aligned to 16 bytes
+        uint32_t _padding0[2];
+    };
 }
\ No newline at end of file
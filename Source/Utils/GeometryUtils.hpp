@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include "Utils/SimdUtils.hpp"
+
 #include <glm/glm.hpp>
+#include <bit>
 
 namespace ThatEngine
 {
@@ -79,7 +82,7 @@ namespace ThatEngine
                 return (position.x >= x && position.x <= width) && (position.y >= y && position.y <= height);
             }
 
-            inline bool IsSphereInsideFrustum(const glm::vec3& position, float radius, Plane planes[6])
+            inline bool IsSphereInsideFrustum(const glm::vec3& position, float radius, const Plane planes[6])
             {
                 for (int i = 0; i < 6; i++)
                 {
@@ -89,6 +92,71 @@ namespace ThatEngine
 
                 return true; 
             }
+
+            // Culls 32 spheres at most and returns their visibility, bit i is set if sphere i is at least partially inside
+            inline uint32_t CullSphereWord(const float* centerX, const float* centerY, const float* centerZ, const float* radius, uint32_t count, const Plane planes[6])
+            {
+                using namespace Simd;
+
+                uint32_t visibilityMask = 0;
+                uint32_t i = 0;
+
+                for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+                {
+                    Vector x = LoadUnaligned(centerX + i);
+                    Vector y = LoadUnaligned(centerY + i);
+                    Vector z = LoadUnaligned(centerZ + i);
+                    Vector negativeRadius = Set(0.0f) - LoadUnaligned(radius + i);
+                    Vector outside = Set(0.0f);
+
+                    for (uint32_t plane = 0; plane < 6; plane++)
+                    {
+                        Vector distance = x * Set(planes[plane].Normal.x) + y * Set(planes[plane].Normal.y) + z * Set(planes[plane].Normal.z) + Set(planes[plane].Distance);
+                        outside = outside | LessThan(distance, negativeRadius);
+                    }
+
+                    visibilityMask |= (~MoveMask(outside) & ((1u << LANE_COUNT) - 1)) << i;
+                }
+
+                // Tail that does not fill a whole register
+                for (; i < count; i++)
+                {
+                    bool isVisible = IsSphereInsideFrustum(glm::vec3(centerX[i], centerY[i], centerZ[i]), radius[i], planes);
+                    visibilityMask |= static_cast<uint32_t>(isVisible) << i;
+                }
+
+                return visibilityMask;
+            }
+
+            // Batched frustum culling over structure-of-arrays spheres, outVisibilityMask needs (count + 31) / 32 words
+            inline void CullSpheres(const float* centerX, const float* centerY, const float* centerZ, const float* radius, uint32_t count, const Plane planes[6], uint32_t* outVisibilityMask)
+            {
+                for (uint32_t first = 0; first < count; first += 32)
+                {
+                    uint32_t wordCount = glm::min(count - first, 32u);
+                    outVisibilityMask[first / 32] = CullSphereWord(centerX + first, centerY + first, centerZ + first, radius + first, wordCount, planes);
+                }
+            }
+
+            // Same as CullSpheres but writes indices of the visible spheres, outVisibleIndices needs room for count indices
+            inline uint32_t CullSpheresCompact(const float* centerX, const float* centerY, const float* centerZ, const float* radius, uint32_t count, const Plane planes[6], uint32_t* outVisibleIndices)
+            {
+                uint32_t visibleCount = 0;
+
+                for (uint32_t first = 0; first < count; first += 32)
+                {
+                    uint32_t wordCount = glm::min(count - first, 32u);
+                    uint32_t visibilityMask = CullSphereWord(centerX + first, centerY + first, centerZ + first, radius + first, wordCount, planes);
+
+                    while (visibilityMask)
+                    {
+                        outVisibleIndices[visibleCount++] = first + static_cast<uint32_t>(std::countr_zero(visibilityMask));
+                        visibilityMask &= visibilityMask - 1;
+                    }
+                }
+
+                return visibleCount;
+            }
         }
     }
 }
\ No newline at end of file
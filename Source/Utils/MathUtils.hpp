@@ -26,6 +26,15 @@ namespace ThatEngine
                 return a + (b - a) * weight;
             }
 
+            // Uniform Catmull-Rom spline segment between b and c, passes through every control point
+            inline glm::vec3 CatmullRom(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d, float weight)
+            {
+                float weight2 = weight * weight;
+                float weight3 = weight2 * weight;
+
+                return 0.5f * ((2.0f * b) + (c - a) * weight + (2.0f * a - 5.0f * b + 4.0f * c - d) * weight2 + (3.0f * b - a - 3.0f * c + d) * weight3);
+            }
+
             template <typename T>
             inline T Remap(T aMin, T aMax, T bMin, T bMax, T weight) 
             {
@@ -11,6 +11,10 @@
 #ifdef PLATFORM_WINDOWS
 #include <Windows.h>
 #include <psapi.h>
+#elif defined(PLATFORM_LINUX)
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
 #endif
 
 namespace ThatEngine
@@ -19,25 +23,86 @@ namespace ThatEngine
     {
         namespace Memory
         {
-            inline float GetCurrentProcessMemoryUsage()
+            // All values in MB
+            struct ProcessMemoryInfo
+            {
+                float Resident = 0.0f;
+                float Proportional = 0.0f; // Shared pages split between the processes mapping them, same as Resident where not available
+                float Peak = 0.0f;         // Peak resident size
+            };
+
+            #ifdef PLATFORM_LINUX
+            // Reads a "Key:   1234 kB" line from a /proc file, returns 0 if it is not there
+            inline float ReadProcKilobytesField(const char* path, const char* key)
+            {
+                FILE* file = std::fopen(path, "r");
+                if (!file) return 0.0f;
+
+                char line[256];
+                size_t keyLength = std::strlen(key);
+                unsigned long long kilobytes = 0;
+
+                while (std::fgets(line, sizeof(line), file))
+                {
+                    if (std::strncmp(line, key, keyLength) != 0) continue;
+
+                    std::sscanf(line + keyLength, " %llu", &kilobytes);
+                    break;
+                }
+
+                std::fclose(file);
+                return static_cast<float>(kilobytes) / 1024.0f;
+            }
+            #endif
+
+            inline ProcessMemoryInfo GetCurrentProcessMemoryInfo()
             {
+                ProcessMemoryInfo info = {};
+
                 #ifdef PLATFORM_WINDOWS
                 {
                     PROCESS_MEMORY_COUNTERS memCounters;
                     if (GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters)))
                     {
-                        return static_cast<float>(memCounters.WorkingSetSize) / (1024.0f * 1024.0f);
+                        info.Resident = static_cast<float>(memCounters.WorkingSetSize) / (1024.0f * 1024.0f);
+                        info.Proportional = info.Resident;
+                        info.Peak = static_cast<float>(memCounters.PeakWorkingSetSize) / (1024.0f * 1024.0f);
                     }
-
-                    return 0.0f;
                 }
-                
-                #else
+
+                #elif defined(PLATFORM_LINUX)
                 {
-                    return 0.0f;
+                    // statm is cheap and always there, second field is resident pages
+                    if (FILE* file = std::fopen("/proc/self/statm", "r"))
+                    {
+                        unsigned long long size = 0;
+                        unsigned long long residentPages = 0;
+                        if (std::fscanf(file, "%llu %llu", &size, &residentPages) == 2)
+                        {
+                            info.Resident = static_cast<float>(residentPages * sysconf(_SC_PAGESIZE)) / (1024.0f * 1024.0f);
+                        }
+
+                        std::fclose(file);
+                    }
+
+                    // smaps_rollup walks every mapping in the kernel, older kernels do not have it
+                    info.Proportional = ReadProcKilobytesField("/proc/self/smaps_rollup", "Pss:");
+                    if (info.Proportional == 0.0f)
+                    {
+                        info.Proportional = info.Resident;
+                    }
+
+                    info.Peak = ReadProcKilobytesField("/proc/self/status", "VmHWM:");
                 }
                 #endif
+
+                return info;
+            }
+
+            inline float GetCurrentProcessMemoryUsage()
+            {
+                return GetCurrentProcessMemoryInfo().Resident;
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,179 @@
+//
+// File: SimdUtils.hpp
+// Description: Thin wrapper over SSE2 or AVX2 registers with the same interface for a scalar fallback,
+//              lane count is picked at compile time (/arch:AVX2 enables the 8-wide path)
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ThatEngine
+{
+    namespace Utils
+    {
+        namespace Simd
+        {
+            #if defined(__AVX2__)
+            constexpr uint32_t LANE_COUNT = 8;
+
+            struct Vector { __m256 Value; };
+            struct VectorInt { __m256i Value; };
+
+            inline Vector Set(float value) { return { _mm256_set1_ps(value) }; }
+            inline Vector Load(const float* data) { return { _mm256_load_ps(data) }; }
+            inline Vector LoadUnaligned(const float* data) { return { _mm256_loadu_ps(data) }; }
+            inline void Store(float* data, Vector vector) { _mm256_store_ps(data, vector.Value); }
+
+            inline Vector operator+(Vector a, Vector b) { return { _mm256_add_ps(a.Value, b.Value) }; }
+            inline Vector operator-(Vector a, Vector b) { return { _mm256_sub_ps(a.Value, b.Value) }; }
+            inline Vector operator*(Vector a, Vector b) { return { _mm256_mul_ps(a.Value, b.Value) }; }
+            inline Vector operator&(Vector a, Vector b) { return { _mm256_and_ps(a.Value, b.Value) }; }
+            inline Vector operator|(Vector a, Vector b) { return { _mm256_or_ps(a.Value, b.Value) }; }
+            inline Vector operator^(Vector a, Vector b) { return { _mm256_xor_ps(a.Value, b.Value) }; }
+            inline Vector AndNot(Vector a, Vector b) { return { _mm256_andnot_ps(a.Value, b.Value) }; }
+            inline Vector Select(Vector mask, Vector a, Vector b) { return { _mm256_blendv_ps(b.Value, a.Value, mask.Value) }; }
+            inline Vector LessThan(Vector a, Vector b) { return { _mm256_cmp_ps(a.Value, b.Value, _CMP_LT_OQ) }; }
+            inline uint32_t MoveMask(Vector mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask.Value)); }
+
+            inline VectorInt SetInt(int32_t value) { return { _mm256_set1_epi32(value) }; }
+            inline VectorInt operator+(VectorInt a, VectorInt b) { return { _mm256_add_epi32(a.Value, b.Value) }; }
+            inline VectorInt operator-(VectorInt a, VectorInt b) { return { _mm256_sub_epi32(a.Value, b.Value) }; }
+            inline VectorInt operator&(VectorInt a, VectorInt b) { return { _mm256_and_si256(a.Value, b.Value) }; }
+            inline VectorInt AndNot(VectorInt a, VectorInt b) { return { _mm256_andnot_si256(a.Value, b.Value) }; }
+            inline Vector Equal(VectorInt a, VectorInt b) { return { _mm256_castsi256_ps(_mm256_cmpeq_epi32(a.Value, b.Value)) }; }
+
+            template<int Count>
+            inline VectorInt ShiftLeft(VectorInt a) { return { _mm256_slli_epi32(a.Value, Count) }; }
+
+            inline VectorInt ConvertToInt(Vector a) { return { _mm256_cvttps_epi32(a.Value) }; }
+            inline Vector ConvertToFloat(VectorInt a) { return { _mm256_cvtepi32_ps(a.Value) }; }
+            inline Vector AsFloat(VectorInt a) { return { _mm256_castsi256_ps(a.Value) }; }
+
+            #elif defined(_M_X64) || defined(__SSE2__)
+            constexpr uint32_t LANE_COUNT = 4;
+
+            struct Vector { __m128 Value; };
+            struct VectorInt { __m128i Value; };
+
+            inline Vector Set(float value) { return { _mm_set1_ps(value) }; }
+            inline Vector Load(const float* data) { return { _mm_load_ps(data) }; }
+            inline Vector LoadUnaligned(const float* data) { return { _mm_loadu_ps(data) }; }
+            inline void Store(float* data, Vector vector) { _mm_store_ps(data, vector.Value); }
+
+            inline Vector operator+(Vector a, Vector b) { return { _mm_add_ps(a.Value, b.Value) }; }
+            inline Vector operator-(Vector a, Vector b) { return { _mm_sub_ps(a.Value, b.Value) }; }
+            inline Vector operator*(Vector a, Vector b) { return { _mm_mul_ps(a.Value, b.Value) }; }
+            inline Vector operator&(Vector a, Vector b) { return { _mm_and_ps(a.Value, b.Value) }; }
+            inline Vector operator|(Vector a, Vector b) { return { _mm_or_ps(a.Value, b.Value) }; }
+            inline Vector operator^(Vector a, Vector b) { return { _mm_xor_ps(a.Value, b.Value) }; }
+            inline Vector AndNot(Vector a, Vector b) { return { _mm_andnot_ps(a.Value, b.Value) }; }
+            inline Vector Select(Vector mask, Vector a, Vector b) { return { _mm_or_ps(_mm_and_ps(mask.Value, a.Value), _mm_andnot_ps(mask.Value, b.Value)) }; }
+            inline Vector LessThan(Vector a, Vector b) { return { _mm_cmplt_ps(a.Value, b.Value) }; }
+            inline uint32_t MoveMask(Vector mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask.Value)); }
+
+            inline VectorInt SetInt(int32_t value) { return { _mm_set1_epi32(value) }; }
+            inline VectorInt operator+(VectorInt a, VectorInt b) { return { _mm_add_epi32(a.Value, b.Value) }; }
+            inline VectorInt operator-(VectorInt a, VectorInt b) { return { _mm_sub_epi32(a.Value, b.Value) }; }
+            inline VectorInt operator&(VectorInt a, VectorInt b) { return { _mm_and_si128(a.Value, b.Value) }; }
+            inline VectorInt AndNot(VectorInt a, VectorInt b) { return { _mm_andnot_si128(a.Value, b.Value) }; }
+            inline Vector Equal(VectorInt a, VectorInt b) { return { _mm_castsi128_ps(_mm_cmpeq_epi32(a.Value, b.Value)) }; }
+
+            template<int Count>
+            inline VectorInt ShiftLeft(VectorInt a) { return { _mm_slli_epi32(a.Value, Count) }; }
+
+            inline VectorInt ConvertToInt(Vector a) { return { _mm_cvttps_epi32(a.Value) }; }
+            inline Vector ConvertToFloat(VectorInt a) { return { _mm_cvtepi32_ps(a.Value) }; }
+            inline Vector AsFloat(VectorInt a) { return { _mm_castsi128_ps(a.Value) }; }
+
+            #else
+            constexpr uint32_t LANE_COUNT = 1;
+
+            struct Vector { float Value; };
+            struct VectorInt { int32_t Value; };
+
+            inline uint32_t Bits(Vector a) { return std::bit_cast<uint32_t>(a.Value); }
+            inline Vector FromBits(uint32_t bits) { return { std::bit_cast<float>(bits) }; }
+
+            inline Vector Set(float value) { return { value }; }
+            inline Vector Load(const float* data) { return { *data }; }
+            inline Vector LoadUnaligned(const float* data) { return { *data }; }
+            inline void Store(float* data, Vector vector) { *data = vector.Value; }
+
+            inline Vector operator+(Vector a, Vector b) { return { a.Value + b.Value }; }
+            inline Vector operator-(Vector a, Vector b) { return { a.Value - b.Value }; }
+            inline Vector operator*(Vector a, Vector b) { return { a.Value * b.Value }; }
+            inline Vector operator&(Vector a, Vector b) { return FromBits(Bits(a) & Bits(b)); }
+            inline Vector operator|(Vector a, Vector b) { return FromBits(Bits(a) | Bits(b)); }
+            inline Vector operator^(Vector a, Vector b) { return FromBits(Bits(a) ^ Bits(b)); }
+            inline Vector AndNot(Vector a, Vector b) { return FromBits(~Bits(a) & Bits(b)); }
+            inline Vector Select(Vector mask, Vector a, Vector b) { return FromBits((Bits(mask) & Bits(a)) | (~Bits(mask) & Bits(b))); }
+            inline Vector LessThan(Vector a, Vector b) { return FromBits(a.Value < b.Value ? UINT32_MAX : 0u); }
+            inline uint32_t MoveMask(Vector mask) { return Bits(mask) >> 31; }
+
+            inline VectorInt SetInt(int32_t value) { return { value }; }
+            inline VectorInt operator+(VectorInt a, VectorInt b) { return { a.Value + b.Value }; }
+            inline VectorInt operator-(VectorInt a, VectorInt b) { return { a.Value - b.Value }; }
+            inline VectorInt operator&(VectorInt a, VectorInt b) { return { a.Value & b.Value }; }
+            inline VectorInt AndNot(VectorInt a, VectorInt b) { return { ~a.Value & b.Value }; }
+            inline Vector Equal(VectorInt a, VectorInt b) { return FromBits(a.Value == b.Value ? UINT32_MAX : 0u); }
+
+            template<int Count>
+            inline VectorInt ShiftLeft(VectorInt a) { return { static_cast<int32_t>(static_cast<uint32_t>(a.Value) << Count) }; }
+
+            inline VectorInt ConvertToInt(Vector a) { return { static_cast<int32_t>(a.Value) }; }
+            inline Vector ConvertToFloat(VectorInt a) { return { static_cast<float>(a.Value) }; }
+            inline Vector AsFloat(VectorInt a) { return { std::bit_cast<float>(a.Value) }; }
+            #endif
+
+            // Sine and cosine of every lane in radians, Cephes range reduction and minimax polynomials,
+            // accurate to a few ulp for |x| up to a few thousand radians
+            inline void SinCos(Vector x, Vector& outSin, Vector& outCos)
+            {
+                const Vector signMask = AsFloat(SetInt(static_cast<int32_t>(0x80000000)));
+
+                Vector sinSign = x & signMask;
+                x = AndNot(signMask, x);
+
+                // Octant, rounded up to even so the remainder is in [-pi/4, pi/4]
+                VectorInt octant = ConvertToInt(x * Set(1.27323954473516f));
+                octant = (octant + SetInt(1)) & SetInt(~1);
+                Vector y = ConvertToFloat(octant);
+
+                sinSign = sinSign ^ AsFloat(ShiftLeft<29>(octant & SetInt(4)));
+                Vector cosSign = AsFloat(ShiftLeft<29>(AndNot(octant - SetInt(2), SetInt(4))));
+                Vector polynomialMask = Equal(octant & SetInt(2), SetInt(0));
+
+                // Extended precision subtraction of the octant multiple of pi/4
+                x = x - y * Set(0.78515625f);
+                x = x - y * Set(2.4187564849853515625e-4f);
+                x = x - y * Set(3.77489497744594108e-8f);
+
+                Vector z = x * x;
+
+                Vector cosPolynomial = Set(2.443315711809948e-5f);
+                cosPolynomial = cosPolynomial * z + Set(-1.388731625493765e-3f);
+                cosPolynomial = cosPolynomial * z + Set(4.166664568298827e-2f);
+                cosPolynomial = cosPolynomial * z * z - z * Set(0.5f) + Set(1.0f);
+
+                Vector sinPolynomial = Set(-1.9515295891e-4f);
+                sinPolynomial = sinPolynomial * z + Set(8.3321608736e-3f);
+                sinPolynomial = sinPolynomial * z + Set(-1.6666654611e-1f);
+                sinPolynomial = sinPolynomial * z * x + x;
+
+                outSin = Select(polynomialMask, sinPolynomial, cosPolynomial) ^ sinSign;
+                outCos = Select(polynomialMask, cosPolynomial, sinPolynomial) ^ cosSign;
+            }
+        }
+    }
+}
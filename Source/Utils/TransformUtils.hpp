@@ -0,0 +1,73 @@
+//
+// File: TransformUtils.hpp
+// Description: Vectorized rebuild of transform basis vectors from pitch and yaw
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Utils/SimdUtils.hpp"
+
+namespace ThatEngine
+{
+    namespace Utils
+    {
+        namespace Transform
+        {
+            // Transforms are gathered into structure-of-arrays batches, processed Simd::LANE_COUNT at a time
+            struct TransformBatch
+            {
+                static constexpr uint32_t SIZE = 8;
+                static_assert(SIZE % Simd::LANE_COUNT == 0, "Transform batch size has to be a multiple of the SIMD lane count!");
+
+                // Input, degrees
+                alignas(32) float Pitch[SIZE];
+                alignas(32) float Yaw[SIZE];
+
+                // Output, unit vectors
+                alignas(32) float ForwardX[SIZE];
+                alignas(32) float ForwardY[SIZE];
+                alignas(32) float ForwardZ[SIZE];
+                alignas(32) float RightX[SIZE];
+                alignas(32) float RightZ[SIZE]; // Right never leaves the horizontal plane
+                alignas(32) float UpX[SIZE];
+                alignas(32) float UpY[SIZE];
+                alignas(32) float UpZ[SIZE];
+            };
+
+            // Closed form of Forward = (cos p * sin y, sin p, cos p * cos y), Right = normalize(Forward x -Y) and
+            // Up = Forward x Right, one sincos per angle and no normalization
+            inline void BuildBasis(TransformBatch& batch, uint32_t count)
+            {
+                using namespace Simd;
+
+                const Vector degreesToRadians = Set(0.0174532925199433f);
+                const Vector zero = Set(0.0f);
+
+                for (uint32_t i = 0; i < count; i += LANE_COUNT)
+                {
+                    Vector sinPitch, cosPitch, sinYaw, cosYaw;
+                    SinCos(Load(batch.Pitch + i) * degreesToRadians, sinPitch, cosPitch);
+                    SinCos(Load(batch.Yaw + i) * degreesToRadians, sinYaw, cosYaw);
+
+                    // Right and Up flip once the camera is upside down, same as the cross products do
+                    Vector sign = Select(LessThan(cosPitch, zero), Set(-1.0f), Set(1.0f));
+
+                    Store(batch.ForwardX + i, cosPitch * sinYaw);
+                    Store(batch.ForwardY + i, sinPitch);
+                    Store(batch.ForwardZ + i, cosPitch * cosYaw);
+
+                    Store(batch.RightX + i, sign * cosYaw);
+                    Store(batch.RightZ + i, zero - sign * sinYaw);
+
+                    Vector signedSinPitch = sign * sinPitch;
+                    Store(batch.UpX + i, zero - signedSinPitch * sinYaw);
+                    Store(batch.UpY + i, sign * cosPitch);
+                    Store(batch.UpZ + i, zero - signedSinPitch * cosYaw);
+                }
+            }
+        }
+    }
+}
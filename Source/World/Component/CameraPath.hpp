@@ -0,0 +1,26 @@
+//
+// File: CameraPath.hpp
+// Description: ECS component that moves a camera along a closed spline, used by scripted benchmarks
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace ThatEngine
+{
+    namespace ECS
+    {
+        struct CameraPath
+        {
+            std::vector<glm::vec3> Points;      // Control points of a closed Catmull-Rom loop
+            glm::vec3 Target = { 0.0f, 0.0f, 0.0f };
+            float Duration = 20.0f;             // Seconds for one loop
+            float Time = 0.0f;
+        };
+    }
+}
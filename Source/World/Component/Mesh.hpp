@@ -19,6 +19,7 @@ namespace ThatEngine
         struct Mesh
         {
             MeshAssetType Type = MeshAssetType::None;
+            uint32_t InstanceSlot = INVALID_UINT32_ID;  // Assigned by MeshInstanceStore when the component is added
         };
     }
 }
@@ -22,6 +22,7 @@ namespace ThatEngine
             float FontSize;
             glm::vec4 Color;
             std::string Content;
+            bool IsVisible = true;
         };
     }
 }
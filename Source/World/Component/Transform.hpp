@@ -1,6 +1,7 @@
 //
 // File: Transform.hpp
-// Description: ECS component storing transform and model data
+// Description: ECS component storing the hot transform data that systems write every frame,
+//              derived vectors and the model matrix live in TransformMatrix
 //
 // Copyright (c) 2025 Sneshu
 // All rights reserved.
@@ -20,12 +21,6 @@ namespace ThatEngine
             glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f };
             glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
 
-            glm::vec3 Forward = { 0.0f, 0.0f, 1.0f };
-            glm::vec3 Up = { 0.0f, 1.0f, 0.0f };
-            glm::vec3 Right = { 1.0f, 0.0f, 0.0f };
-
-            glm::mat4 Model;
-
             float BoundingRadius = glm::length(Scale) * 0.5f;
             bool IsVisible = false;
             bool IsActive = true;
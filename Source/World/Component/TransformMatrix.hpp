@@ -0,0 +1,30 @@
+//
+// File: TransformMatrix.hpp
+// Description: ECS component storing the cold transform data rebuilt from Transform when it is dirty,
+//              added automatically to every entity that gets a Transform
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace ThatEngine
+{
+    namespace ECS
+    {
+        struct TransformMatrix
+        {
+            glm::vec3 Forward = { 0.0f, 0.0f, 1.0f };
+            glm::vec3 Up = { 0.0f, 1.0f, 0.0f };
+            glm::vec3 Right = { 1.0f, 0.0f, 0.0f };
+
+            glm::mat4 Model = glm::mat4(1.0f);
+
+            // Set whenever Model is rebuilt, cleared once the change reaches the GPU
+            bool IsModelChanged = true;
+        };
+    }
+}
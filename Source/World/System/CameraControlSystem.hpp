@@ -13,6 +13,7 @@
 #include "Core/Input.hpp"
 #include "Types/ECSTypes.hpp"
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
 #include "World/Component/Camera.hpp"
 #include "World/Component/Movement.hpp"
 #include "World/Component/PlayerControl.hpp"
@@ -31,6 +32,7 @@ namespace ThatEngine
             Entity entity = world->GetActiveCamera();
 
             auto& transform = registry.get<ECS::Transform>(entity);
+            const auto& matrix = registry.get<ECS::TransformMatrix>(entity);
             auto& movement = registry.get<ECS::Movement>(entity);
             const auto& camera = registry.get<ECS::Camera>(entity);
             const auto& playerControl = registry.get<ECS::PlayerControl>(entity);
@@ -39,22 +41,22 @@ namespace ThatEngine
 
             if (Input::IsKeyDown(playerControl.MoveForwardKey))
             {
-                direction += transform.Forward;
+                direction += matrix.Forward;
             }
 
             if (Input::IsKeyDown(playerControl.MoveBackwardKey))
             {
-                direction -= transform.Forward;
+                direction -= matrix.Forward;
             }
 
             if (Input::IsKeyDown(playerControl.StrafeRightKey))
             {
-                direction += transform.Right;
+                direction += matrix.Right;
             }
 
             if (Input::IsKeyDown(playerControl.StrafeLeftKey))
             {
-                direction -= transform.Right;
+                direction -= matrix.Right;
             }
 
             if (Input::IsKeyDown(playerControl.JumpKey))
@@ -0,0 +1,57 @@
+//
+// File: FollowCameraPathSystem.hpp
+// Description: ECS system that moves the active camera along its path while looking at the path's target
+//
+// Copyright (c) 2025 Sneshu
+// All rights reserved.
+//
+
+#pragma once
+
+#include "Core/PCH.hpp"
+#include "Types/ECSTypes.hpp"
+#include "Utils/MathUtils.hpp"
+#include "World/Component/Transform.hpp"
+#include "World/Component/CameraPath.hpp"
+
+namespace ThatEngine
+{
+    namespace ECS
+    {
+        void FollowCameraPathSystem(ECS::Registry& registry, Timestep deltaTime)
+        {
+            World* world = registry.ctx().get<World*>();
+            Entity entity = world->GetActiveCamera();
+
+            auto* path = registry.try_get<ECS::CameraPath>(entity);
+            if (!path || path->Points.size() < 2) return;
+
+            auto& transform = registry.get<ECS::Transform>(entity);
+
+            // Driven by the frame's delta time, a fixed timestep replays the same path every run
+            path->Time = glm::mod(path->Time + deltaTime.GetSeconds(), path->Duration);
+
+            const uint32_t pointCount = static_cast<uint32_t>(path->Points.size());
+            const float position = path->Time / path->Duration * pointCount;
+            const uint32_t segment = glm::min(static_cast<uint32_t>(position), pointCount - 1);
+
+            const glm::vec3& a = path->Points[(segment + pointCount - 1) % pointCount];
+            const glm::vec3& b = path->Points[segment];
+            const glm::vec3& c = path->Points[(segment + 1) % pointCount];
+            const glm::vec3& d = path->Points[(segment + 2) % pointCount];
+            const glm::vec3 point = Utils::Math::CatmullRom(a, b, c, d, position - segment);
+
+            transform.SetPosition(point.x, point.y, point.z);
+
+            // Camera looks against its forward vector
+            glm::vec3 direction = path->Target - point;
+            if (glm::dot(direction, direction) == 0.0f) return;
+
+            direction = glm::normalize(direction);
+            float pitch = glm::degrees(glm::asin(-direction.y));
+            float yaw = glm::degrees(glm::atan(-direction.x, -direction.z));
+
+            transform.SetRotation(glm::clamp(pitch, -89.99f, 89.99f), yaw, 0.0f);
+        }
+    }
+}
@@ -27,6 +27,8 @@ namespace ThatEngine
             {
                 transform.Rotate(0.0f, 45.0f * deltaTime.GetSeconds(), 0.0f);
             });
+
+            SystemManager::SetProcessedEntityCount(static_cast<uint32_t>(view.size_hint()));
         }
     }
 }
\ No newline at end of file
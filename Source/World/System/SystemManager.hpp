@@ -1,6 +1,7 @@
 //
 // File: SystemManager.hpp
-// Description: 
+// Description: Owns ECS systems, orders them by their declared data access and runs
+//              systems that do not conflict in parallel
 //
 // Copyright (c) 2025 Sneshu
 // All rights reserved.
@@ -9,34 +10,355 @@
 #pragma once
 
 #include "Core/Timestep.hpp"
+#include "Core/Timer.hpp"
+#include "Core/RollingStatistics.hpp"
+#include "Core/MemoryTracker.hpp"
+#include "Core/JobManager.hpp"
+#include "Core/Job/TaskGraph.hpp"
 #include "Types/ECSTypes.hpp"
 
 #include <functional>
+#include <algorithm>
 
 namespace ThatEngine
 {
     namespace ECS
     {
+        // Access type shared by every system, exclusive systems write it
+        struct ExclusiveSystemAccess {};
+
+        struct SystemStats
+        {
+            std::string Name;
+            float LastTime;    // ms
+            float MinTime;     // ms
+            float AverageTime; // ms
+            float MaxTime;     // ms
+            float P99Time;     // ms
+            float Budget;      // ms, 0 if the system has none
+            uint32_t ProcessedEntityCount;
+            uint32_t BudgetOverrunCount;
+        };
+
         class SystemManager
         {
+            public:
+            static constexpr uint32_t STATS_WINDOW_SIZE = 240;
+            static constexpr float NO_SYSTEM_BUDGET = 0.0f; // Systems are only checked against a budget that was set for them
+            static constexpr float BUDGET_WARNING_INTERVAL = 1.0f; // seconds
+
             public:
             SystemManager() = default;
 
-            void AddSystem(SystemFunction system)
+            // System without declared access, it never overlaps with any other system
+            void AddSystem(const std::string& name, SystemFunction system)
+            {
+                SystemData data = {};
+                data.Name = name;
+                data.Function = system;
+                data.IsExclusive = true;
+
+                m_RegisteredSystems.push_back(std::move(data));
+            }
+
+            // Systems are ordered by registration, only where their access conflicts
+            template<typename... ReadTypes, typename... WriteTypes>
+            void AddSystem(const std::string& name, SystemFunction system, ECS::Read<ReadTypes...>, ECS::Write<WriteTypes...>)
+            {
+                SystemData data = {};
+                data.Name = name;
+                data.Function = system;
+                data.Reads = { entt::type_hash<ReadTypes>::value()... };
+                data.Writes = { entt::type_hash<WriteTypes>::value()... };
+
+                m_RegisteredSystems.push_back(std::move(data));
+            }
+
+            // Builds the dependency graph, call once after every system is registered
+            void Build()
             {
-                m_RegisteredSystems.push_back(system);
+                const uint32_t systemCount = static_cast<uint32_t>(m_RegisteredSystems.size());
+
+                // Exclusive systems write everything anybody touches
+                {
+                    std::vector<entt::id_type> accessTypes = { EXCLUSIVE_ACCESS_ID };
+                    for (const auto& system : m_RegisteredSystems)
+                    {
+                        accessTypes.insert(accessTypes.end(), system.Reads.begin(), system.Reads.end());
+                        accessTypes.insert(accessTypes.end(), system.Writes.begin(), system.Writes.end());
+                    }
+
+                    std::sort(accessTypes.begin(), accessTypes.end());
+                    accessTypes.erase(std::unique(accessTypes.begin(), accessTypes.end()), accessTypes.end());
+
+                    for (auto& system : m_RegisteredSystems)
+                    {
+                        if (system.IsExclusive)
+                        {
+                            system.Writes = accessTypes;
+                        }
+
+                        else
+                        {
+                            system.Reads.push_back(EXCLUSIVE_ACCESS_ID);
+                        }
+
+                        // Writing implies reading
+                        std::erase_if(system.Reads, [&](entt::id_type type) { return Contains(system.Writes, type); });
+                    }
+
+                    m_AccessTypes = std::move(accessTypes);
+                }
+
+                // Tasks
+                std::vector<TaskId> tasks(systemCount);
+                for (uint32_t i = 0; i < systemCount; i++)
+                {
+                    tasks[i] = m_Graph.AddTask(m_RegisteredSystems[i].Name, [this, i]()
+                    {
+                        RunSystem(i);
+                    });
+                }
+
+                // Dependencies, an earlier conflicting system only gets an edge if it is not already an ancestor
+                std::vector<std::vector<bool>> ancestors(systemCount, std::vector<bool>(systemCount, false));
+                for (uint32_t successor = 0; successor < systemCount; successor++)
+                {
+                    for (int32_t predecessor = static_cast<int32_t>(successor) - 1; predecessor >= 0; predecessor--)
+                    {
+                        if (ancestors[successor][predecessor]) continue;
+                        if (!HasConflict(m_RegisteredSystems[predecessor], m_RegisteredSystems[successor])) continue;
+
+                        m_Graph.AddDependency(tasks[predecessor], tasks[successor]);
+                        THAT_CORE_INFO("System Manager: '{}' runs after '{}'", m_RegisteredSystems[successor].Name, m_RegisteredSystems[predecessor].Name);
+
+                        ancestors[successor][predecessor] = true;
+                        for (uint32_t i = 0; i < systemCount; i++)
+                        {
+                            if (ancestors[predecessor][i]) ancestors[successor][i] = true;
+                        }
+                    }
+                }
+
+                bool isBuilt = m_Graph.Build();
+                THAT_CORE_ASSERT(isBuilt, "System Manager: Failed to build system graph!", 0);
+
+                #ifdef DEBUG
+                // Conflicting systems must never be able to run at the same time
+                for (uint32_t successor = 0; successor < systemCount; successor++)
+                {
+                    for (uint32_t predecessor = 0; predecessor < successor; predecessor++)
+                    {
+                        bool isOrdered = ancestors[successor][predecessor];
+                        bool hasConflict = HasConflict(m_RegisteredSystems[predecessor], m_RegisteredSystems[successor]);
+                        THAT_CORE_ASSERT(isOrdered || !hasConflict, "System Manager: '{}' and '{}' conflict but are not ordered!", m_RegisteredSystems[predecessor].Name, m_RegisteredSystems[successor].Name);
+                    }
+                }
+
+                m_AccessStates = CreateUnique<std::atomic<int32_t>[]>(m_AccessTypes.size());
+                #endif
             }
 
             void Update(ECS::Registry& registry, Timestep deltaTime)
+            {
+                m_Registry = &registry;
+                m_DeltaTime = deltaTime;
+
+                Timer timer;
+                m_Graph.Execute(*registry.ctx().get<JobManager*>());
+
+                float updateTime = timer.GetElapsedTime().GetMilliseconds();
+                m_UpdateTime.AddSample(updateTime);
+                TracyPlot("Systems", updateTime);
+            }
+
+            // Time above which a system counts as over budget and gets reported, in milliseconds
+            void SetSystemBudget(const std::string& name, float budget)
             {
                 for (auto& system : m_RegisteredSystems)
                 {
-                    system(registry, deltaTime);
+                    if (system.Name != name) continue;
+
+                    system.Budget = budget;
+                    return;
+                }
+
+                THAT_CORE_WARN("System Manager: Cannot set budget, system '{}' is not registered!", name);
+            }
+
+            // Called from inside a system, reports how many entities it went through this frame
+            static void SetProcessedEntityCount(uint32_t count)
+            {
+                if (!s_CurrentSystem) return;
+
+                s_CurrentSystem->ProcessedEntityCount = count;
+            }
+
+            // Wall time of the whole system graph, in milliseconds
+            inline const RollingStatistics<STATS_WINDOW_SIZE>& GetUpdateTime() const { return m_UpdateTime; }
+
+            SystemStats GetSystemStats(uint32_t index) const
+            {
+                const SystemData& system = m_RegisteredSystems[index];
+
+                SystemStats stats = {};
+                stats.Name = system.Name;
+                stats.LastTime = system.Time.GetLast();
+                stats.MinTime = system.Time.GetMin();
+                stats.AverageTime = system.Time.GetAverage();
+                stats.MaxTime = system.Time.GetMax();
+                stats.P99Time = system.Time.GetPercentile(0.99f);
+                stats.Budget = system.Budget;
+                stats.ProcessedEntityCount = system.ProcessedEntityCount;
+                stats.BudgetOverrunCount = system.BudgetOverrunCount;
+
+                return stats;
+            }
+
+            inline uint32_t GetSystemCount() const { return static_cast<uint32_t>(m_RegisteredSystems.size()); }
+            inline float GetSystemLastTime(uint32_t index) const { return m_RegisteredSystems[index].Time.GetLast(); }
+
+            private:
+            struct SystemData
+            {
+                std::string Name;
+                SystemFunction Function;
+                std::vector<entt::id_type> Reads;
+                std::vector<entt::id_type> Writes;
+                bool IsExclusive = false;
+
+                // Stats, only touched by the thread running the system
+                RollingStatistics<STATS_WINDOW_SIZE> Time;
+                Timer WarningTimer;
+                float Budget = NO_SYSTEM_BUDGET;
+                uint32_t ProcessedEntityCount = 0;
+                uint32_t BudgetOverrunCount = 0;
+            };
+
+            static bool Contains(const std::vector<entt::id_type>& types, entt::id_type type)
+            {
+                return std::find(types.begin(), types.end(), type) != types.end();
+            }
+
+            static bool HasConflict(const SystemData& first, const SystemData& second)
+            {
+                for (entt::id_type type : first.Writes)
+                {
+                    if (Contains(second.Writes, type) || Contains(second.Reads, type)) return true;
+                }
+
+                for (entt::id_type type : second.Writes)
+                {
+                    if (Contains(first.Reads, type)) return true;
+                }
+
+                return false;
+            }
+
+            void RunSystem(uint32_t index)
+            {
+                SystemData& system = m_RegisteredSystems[index];
+
+                #ifdef DEBUG
+                AcquireAccess(system);
+                #endif
+
+                // Waiting on jobs can run another ready system nested on this thread, so the outer one is restored afterwards
+                SystemData* outerSystem = s_CurrentSystem;
+                const float outerNestedTime = s_NestedSystemTime;
+                s_CurrentSystem = &system;
+                s_NestedSystemTime = 0.0f;
+                system.ProcessedEntityCount = 0;
+
+                Timer timer;
+                {
+                    ScopedAllocationTag allocationTag(AllocationTag::ECS);
+                    system.Function(*m_Registry, m_DeltaTime);
+                }
+                const float totalTime = timer.GetElapsedTime().GetMilliseconds();
+
+                // Nested systems record their own time, it is not counted against this one
+                float time = totalTime - s_NestedSystemTime;
+
+                s_CurrentSystem = outerSystem;
+                s_NestedSystemTime = outerSystem ? outerNestedTime + totalTime : 0.0f;
+
+                #ifdef DEBUG
+                ReleaseAccess(system);
+                #endif
+
+                system.Time.AddSample(time);
+                TracyPlot(system.Name.c_str(), time);
+
+                if (system.Budget != NO_SYSTEM_BUDGET && time > system.Budget)
+                {
+                    system.BudgetOverrunCount++;
+
+                    // Rate limited, a system that is always slow should not flood the log
+                    if (system.WarningTimer.GetElapsedTime().GetSeconds() >= BUDGET_WARNING_INTERVAL)
+                    {
+                        THAT_CORE_WARN("System Manager: '{}' took {:.3f} ms, budget is {:.3f} ms (avg {:.3f} ms, p99 {:.3f} ms, {} entities)",
+                            system.Name, time, system.Budget, system.Time.GetAverage(), system.Time.GetPercentile(0.99f), system.ProcessedEntityCount);
+                        system.WarningTimer.Reset();
+                    }
                 }
             }
 
+            #ifdef DEBUG
+            // Access state per type is number of readers, or -1 while written
+            uint32_t GetAccessSlot(entt::id_type type) const
+            {
+                auto iterator = std::lower_bound(m_AccessTypes.begin(), m_AccessTypes.end(), type);
+                return static_cast<uint32_t>(iterator - m_AccessTypes.begin());
+            }
+
+            void AcquireAccess(const SystemData& system)
+            {
+                for (entt::id_type type : system.Writes)
+                {
+                    int32_t expected = 0;
+                    bool isAcquired = m_AccessStates[GetAccessSlot(type)].compare_exchange_strong(expected, -1);
+                    THAT_CORE_ASSERT(isAcquired, "System Manager: '{}' writes data that is in use by another system!", system.Name);
+                }
+
+                for (entt::id_type type : system.Reads)
+                {
+                    int32_t previous = m_AccessStates[GetAccessSlot(type)].fetch_add(1);
+                    THAT_CORE_ASSERT(previous >= 0, "System Manager: '{}' reads data that is being written by another system!", system.Name);
+                }
+            }
+
+            void ReleaseAccess(const SystemData& system)
+            {
+                for (entt::id_type type : system.Writes)
+                {
+                    m_AccessStates[GetAccessSlot(type)].store(0);
+                }
+
+                for (entt::id_type type : system.Reads)
+                {
+                    m_AccessStates[GetAccessSlot(type)].fetch_sub(1);
+                }
+            }
+            #endif
+
             private:
-            std::vector<SystemFunction> m_RegisteredSystems;
+            static inline const entt::id_type EXCLUSIVE_ACCESS_ID = entt::type_hash<ExclusiveSystemAccess>::value();
+
+            std::vector<SystemData> m_RegisteredSystems;
+            std::vector<entt::id_type> m_AccessTypes;
+            TaskGraph m_Graph;
+
+            ECS::Registry* m_Registry = nullptr;
+            Timestep m_DeltaTime;
+            RollingStatistics<STATS_WINDOW_SIZE> m_UpdateTime;
+
+            static inline thread_local SystemData* s_CurrentSystem = nullptr;
+            static inline thread_local float s_NestedSystemTime = 0.0f; // ms, of systems run nested inside s_CurrentSystem
+
+            #ifdef DEBUG
+            Unique<std::atomic<int32_t>[]> m_AccessStates;
+            #endif
         };
     }
-}
\ No newline at end of file
+}
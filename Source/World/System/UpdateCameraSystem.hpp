@@ -10,6 +10,7 @@
 
 #include "Core/Window.hpp"
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
 #include "World/Component/Camera.hpp"
 
 namespace ThatEngine
@@ -22,9 +23,10 @@ namespace ThatEngine
             Entity entity = world->GetActiveCamera();
 
             const auto& transform = registry.get<ECS::Transform>(entity);
+            const auto& matrix = registry.get<ECS::TransformMatrix>(entity);
             const auto& camera = registry.get<ECS::Camera>(entity);
 
-            world->UpdateViewProjection(transform, camera);
+            world->UpdateViewProjection(transform, matrix, camera);
         }
     }
 }
\ No newline at end of file
@@ -35,11 +35,18 @@ namespace ThatEngine
                 {
                     if (Input::KeyPressed(Key::GraveAccent))
                     {
-                        registry.get<ECS::Transform>(performanceMonitor.RenderModeEntity).Toggle();
-                        registry.get<ECS::Transform>(performanceMonitor.CpuTimeEntity).Toggle();
-                        registry.get<ECS::Transform>(performanceMonitor.GpuTimeEntity).Toggle();
-                        registry.get<ECS::Transform>(performanceMonitor.RamUsageEntity).Toggle();
-                        registry.get<ECS::Transform>(performanceMonitor.FpsCounterEntity).Toggle();
+                        // Hidden through Text rather than Transform, so this system stays off the transform systems' data
+                        auto toggleText = [&](ECS::Entity entity)
+                        {
+                            auto& text = registry.get<ECS::Text>(entity);
+                            text.IsVisible = !text.IsVisible;
+                        };
+
+                        toggleText(performanceMonitor.RenderModeEntity);
+                        toggleText(performanceMonitor.CpuTimeEntity);
+                        toggleText(performanceMonitor.GpuTimeEntity);
+                        toggleText(performanceMonitor.RamUsageEntity);
+                        toggleText(performanceMonitor.FpsCounterEntity);
                     }
 
                     else if (Input::KeyPressed(Key::D1))
@@ -71,6 +78,11 @@ namespace ThatEngine
                         renderer->SetRenderMode(RenderMode::Wireframe);
                         forceUpdate = true;
                     }
+
+                    else if (Input::KeyPressed(Key::F2))
+                    {
+                        stats->RequestDump();
+                    }
                 }      
 
                 // Update values
@@ -83,20 +95,35 @@ namespace ThatEngine
                     auto& ramUsageText = registry.get<ECS::Text>(performanceMonitor.RamUsageEntity);
                     auto& fpsCounterText = registry.get<ECS::Text>(performanceMonitor.FpsCounterEntity);
                     
+                    // Formats into the existing string so steady-state updates reuse its capacity
+                    auto setContent = [](ECS::Text& text, std::string_view format, const auto&... args)
+                    {
+                        text.Content.clear();
+                        std::vformat_to(std::back_inserter(text.Content), format, std::make_format_args(args...));
+                    };
+
                     const char* renderMode = ToString(renderer->GetRenderMode());
-                    renderModeText.Content = std::format("{}_MODE", renderMode);
+                    setContent(renderModeText, "{}_MODE", renderMode);
 
-                    float cpuTime = stats->GetCpuTime();
-                    cpuTimeText.Content = std::format("CPU: {:.3f} ms", cpuTime);
+                    // Rolling mean with p99, a single sample every update hides stutter
+                    CounterSummary cpuTime = stats->GetCounterSummary(stats->GetCpuTimeCounter());
+                    setContent(cpuTimeText, "CPU: {:.3f} ms (p99 {:.3f} ms)", cpuTime.Average, cpuTime.P99);
                     
-                    float gpuTime = stats->GetGpuTime();
-                    gpuTimeText.Content = std::format("GPU: {:.3f} ms", gpuTime);
+                    CounterSummary gpuTime = stats->GetCounterSummary(stats->GetGpuTimeCounter());
+                    setContent(gpuTimeText, "GPU: {:.3f} ms (p99 {:.3f} ms)", gpuTime.Average, gpuTime.P99);
 
                     float ramUsage = stats->GetRamUsage();
-                    ramUsageText.Content = std::format("RAM: {:.1f} MB", ramUsage);
+                    #ifdef ALLOCATION_TRACKING
+                    uint64_t allocationCount = stats->GetFrameAllocationStats().AllocationCount;
+                    setContent(ramUsageText, "RAM: {:.1f} MB ({} allocs/frame)", ramUsage, allocationCount);
+                    #else
+                    setContent(ramUsageText, "RAM: {:.1f} MB", ramUsage);
+                    #endif
                     
-                    float fps = 1.0f / deltaTime.GetSeconds();
-                    fpsCounterText.Content = std::format("FPS: {:.1f}", fps);
+                    CounterSummary frameTime = stats->GetCounterSummary(stats->GetFrameTimeCounter());
+                    float fps = frameTime.Average > 0.0f ? 1000.0f / frameTime.Average : 0.0f;
+                    uint64_t hitchCount = stats->GetHitchCount();
+                    setContent(fpsCounterText, "FPS: {:.1f} ({} hitches)", fps, hitchCount);
 
                     lifetime.Timer.Reset();
                 }
@@ -10,7 +10,9 @@
 
 #include "Core/PCH.hpp"
 #include "Types/ECSTypes.hpp"
+#include "World/System/SystemManager.hpp"
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
 #include "Utils/GeometryUtils.hpp"
 
 namespace ThatEngine
@@ -19,12 +21,12 @@ namespace ThatEngine
     {
         void UpdateScreenSpaceTransformSystem(ECS::Registry& registry, Timestep deltaTime)
         {
-            auto view = registry.view<ECS::Transform, ECS::ScreenSpace>();
+            auto view = registry.view<ECS::Transform, ECS::TransformMatrix, ECS::ScreenSpace>();
             Window* window = registry.ctx().get<Window*>();
             const float screenWidth = static_cast<float>(window->GetInnerWidth());
             const float screenHeight = static_cast<float>(window->GetInnerHeight());
         
-            view.each([&](auto& transform) 
+            view.each([&](auto& transform, auto& matrix) 
             {
                 // Frustum culling
                 transform.IsVisible = transform.IsActive && Utils::Geometry::IsPointInsideRect(transform.Position, 0.0f, 0.0f, screenWidth, screenHeight);
@@ -35,11 +37,14 @@ namespace ThatEngine
                 glm::mat4 translation = glm::translate(glm::mat4(1.0f), transform.Position);
                 glm::mat4 scale = glm::scale(glm::mat4(1.0f), transform.Scale);
                 
-                transform.Model = translation * scale;
+                matrix.Model = translation * scale;
+                matrix.IsModelChanged = true;
             
                 // Mark as clean
                 transform.IsDirty = false;
             });
+
+            SystemManager::SetProcessedEntityCount(static_cast<uint32_t>(view.size_hint()));
         }
     }
 }
\ No newline at end of file
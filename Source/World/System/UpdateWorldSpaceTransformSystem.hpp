@@ -11,8 +11,12 @@
 #include "Core/PCH.hpp"
 #include "Core/JobManager.hpp"
 #include "Types/ECSTypes.hpp"
+#include "World/System/SystemManager.hpp"
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
+#include "World/Component/Text.hpp"
 #include "Utils/GeometryUtils.hpp"
+#include "Utils/TransformUtils.hpp"
 
 namespace ThatEngine
 {
@@ -20,7 +24,10 @@ namespace ThatEngine
     {
         void UpdateWorldSpaceTransformSystem(ECS::Registry& registry, Timestep deltaTime)
         {
-            auto view = registry.view<ECS::Transform, ECS::WorldSpace>();
+            using Utils::Transform::TransformBatch;
+
+            auto view = registry.view<ECS::Transform, ECS::TransformMatrix, ECS::WorldSpace>();
+            auto textView = registry.view<ECS::Text>();
             auto* world = registry.ctx().get<World*>();
             auto* jobs = registry.ctx().get<JobManager*>();
             auto globalData = world->GetGlobalData();
@@ -28,69 +35,80 @@ namespace ThatEngine
 
             Utils::Geometry::Plane frustumPlanes[6];
             Utils::Geometry::ExtractFrustumPlanes(globalData.PerspectiveViewProjection, frustumPlanes);
-            
-            // Prepare for jobs
-            std::vector<ECS::Entity> entities(view.begin(), view.end());
-            std::vector<std::future<void>> futures;
-            const uint32_t threadCount = jobs->GetThreadCount();
-            const uint32_t entityCount = view.size_hint();
-            const uint32_t batchSize = (entityCount + threadCount - 1) / threadCount;
-
-            for (uint32_t i = 0; i < threadCount; i++)
-            {
-                uint32_t start = i * batchSize;
-                uint32_t end = glm::min(start + batchSize, entityCount);
 
-                if (start >= end) break;
+            const auto* storage = view.handle();
+            if (!storage) return;
 
-                futures.push_back(jobs->Submit([start, end, &entities, &registry, activeCamera, &frustumPlanes]()
+            const auto* entities = storage->data();
+
+            jobs->ParallelFor(0, static_cast<uint32_t>(storage->size()), 0, [&](uint32_t rangeBegin, uint32_t rangeEnd)
+            {
+                // Dirty transforms are gathered into batches so their basis is rebuilt several at a time
+                TransformBatch batch = {};
+                std::array<ECS::Entity, TransformBatch::SIZE> batchEntities;
+                uint32_t batchCount = 0;
+
+                auto flushBatch = [&]()
                 {
-                    for (uint32_t i = start; i < end; i++)
+                    Utils::Transform::BuildBasis(batch, batchCount);
+
+                    for (uint32_t i = 0; i < batchCount; i++)
                     {
-                        auto& transform = registry.get<ECS::Transform>(entities[i]);
-
-                        // Frustum culling
-                        transform.IsVisible = transform.IsActive && Utils::Geometry::IsSphereInsideFrustum(transform.Position, transform.BoundingRadius, frustumPlanes);
-
-                        if ((!transform.IsDirty || !transform.IsVisible) && entities[i] != activeCamera) continue;
-
-                        // Recalculate directional vectors
-                        float pitch = transform.Rotation.x;
-                        float yaw = transform.Rotation.y;
-
-                        glm::vec3 forward = 
-                        {
-                            cos(glm::radians(pitch)) * sin(glm::radians(yaw)),
-                            sin(glm::radians(pitch)),
-                            cos(glm::radians(pitch)) * cos(glm::radians(yaw))
-                        };
-                        
-                        transform.Forward = glm::normalize(forward);
-                        transform.Right = glm::normalize(glm::cross(transform.Forward, glm::vec3(0.0f, -1.0f, 0.0f)));
-                        transform.Up = glm::normalize(glm::cross(transform.Forward, transform.Right));
-                        
-                        // Recalculate model matrix
-                        glm::mat4 translation = glm::translate(glm::mat4(1.0f), transform.Position);
-                        glm::mat4 scale = glm::scale(glm::mat4(1.0f), transform.Scale);
-                        glm::mat4 rotation = glm::mat4(1.0f);
-                        rotation[0] = glm::vec4(transform.Right, 0.0f);
-                        rotation[1] = glm::vec4(transform.Up, 0.0f);
-                        rotation[2] = glm::vec4(transform.Forward, 0.0f);
-                        
+                        auto [transform, matrix] = view.get<ECS::Transform, ECS::TransformMatrix>(batchEntities[i]);
+
+                        matrix.Forward = glm::vec3(batch.ForwardX[i], batch.ForwardY[i], batch.ForwardZ[i]);
+                        matrix.Right = glm::vec3(batch.RightX[i], 0.0f, batch.RightZ[i]);
+                        matrix.Up = glm::vec3(batch.UpX[i], batch.UpY[i], batch.UpZ[i]);
+
+                        // Same as translation * rotation * scale
+                        matrix.Model[0] = glm::vec4(matrix.Right * transform.Scale.x, 0.0f);
+                        matrix.Model[1] = glm::vec4(matrix.Up * transform.Scale.y, 0.0f);
+                        matrix.Model[2] = glm::vec4(matrix.Forward * transform.Scale.z, 0.0f);
+                        matrix.Model[3] = glm::vec4(transform.Position, 1.0f);
+
                         transform.BoundingRadius = glm::length(transform.Scale) * 0.5f;
-                        transform.Model = translation * rotation * scale;
-                    
+                        matrix.IsModelChanged = true;
+
                         // Mark as clean
                         transform.IsDirty = false;
                     }
-                }));
-            }
 
-            // Wait for all jobs to finish
-            for (auto& future : futures) 
-            {
-                future.get();
-            }
+                    batchCount = 0;
+                };
+
+                // Meshes are frustum culled on the GPU, world space text is not drawn through that pass so it is still culled here
+                for (uint32_t i = rangeBegin; i < rangeEnd; i++)
+                {
+                    const auto entity = entities[i];
+                    if (!view.contains(entity)) continue;
+
+                    auto& transform = view.get<ECS::Transform>(entity);
+                    transform.IsVisible = transform.IsActive;
+
+                    if (transform.IsVisible && textView.contains(entity))
+                    {
+                        transform.IsVisible = Utils::Geometry::IsSphereInsideFrustum(transform.Position, transform.BoundingRadius, frustumPlanes);
+                    }
+
+                    if (!transform.IsDirty && entity != activeCamera) continue;
+
+                    batch.Pitch[batchCount] = transform.Rotation.x;
+                    batch.Yaw[batchCount] = transform.Rotation.y;
+                    batchEntities[batchCount] = entity;
+
+                    if (++batchCount == TransformBatch::SIZE)
+                    {
+                        flushBatch();
+                    }
+                }
+
+                if (batchCount > 0)
+                {
+                    flushBatch();
+                }
+            });
+
+            SystemManager::SetProcessedEntityCount(static_cast<uint32_t>(view.size_hint()));
         }
     }
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Core/PCH.hpp"
+#include "Core/JobManager.hpp"
 #include "Types/ECSTypes.hpp"
 #include "World/World.hpp"
 #include "World/Component/Transform.hpp"
@@ -22,16 +23,21 @@ namespace ThatEngine
         {
             auto view = registry.view<ECS::Transform, ECS::Wave>();
             World* world = registry.ctx().get<World*>();
+            auto* jobs = registry.ctx().get<JobManager*>();
             float elapsedTime = world->GetGlobalData().Time;
 
-            view.each([&](auto& transform, const auto& wave)
+            jobs->ParallelForEach(view, 0, [&](ECS::Entity entity)
             {
+                auto [transform, wave] = view.get<ECS::Transform, ECS::Wave>(entity);
+
                 float sinValue = glm::sin(wave.Frequency * elapsedTime + wave.FrequencyOffset);
                 float cosValue = glm::cos(wave.Frequency * elapsedTime + wave.FrequencyOffset);
 
                 float positionY = 0.5f * (sinValue * wave.MaxHeight + cosValue * wave.MaxHeight);
                 transform.SetPosition(transform.Position.x, positionY, transform.Position.z);
             });
+
+            SystemManager::SetProcessedEntityCount(static_cast<uint32_t>(view.size_hint()));
         }
     }
 }
\ No newline at end of file
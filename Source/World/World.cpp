@@ -7,14 +7,17 @@
 
 #include "Core/PCH.hpp"
 #include "Core/KeyCodes.hpp"
+#include "Core/Input.hpp"
 #include "World/World.hpp"
 #include "Core/StatsTracker.hpp"
+#include "Core/FrameAllocator.hpp"
 #include "Types/ECSTypes.hpp"
 #include "Types/RendererTypes.hpp"
 #include "Utils/ColorUtils.hpp"
 
 // Components
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
 #include "World/Component/WorldSpace.hpp"
 #include "World/Component/ScreenSpace.hpp"
 #include "World/Component/Camera.hpp"
@@ -24,11 +27,14 @@
 #include "World/Component/Text.hpp"
 #include "World/Component/Wave.hpp"
 #include "World/Component/PerformanceMonitor.hpp"
+#include "World/Component/Lifetime.hpp"
+#include "World/Component/CameraPath.hpp"
 // Systems
 #include "World/System/UpdateWorldSpaceTransformSystem.hpp"
 #include "World/System/UpdateScreenSpaceTransformSystem.hpp"
 #include "World/System/UpdateCameraSystem.hpp"
 #include "World/System/CameraControlSystem.hpp"
+#include "World/System/FollowCameraPathSystem.hpp"
 #include "World/System/UpdatePerformanceMonitorSystem.hpp" 
 #include "World/System/WaveSystem.hpp"
 #include "World/System/RotateTextSystem.hpp"
@@ -37,8 +43,9 @@
 
 namespace ThatEngine
 {
-    void World::Init(Window* window, ResourceManager* resources, JobManager* jobs, Renderer* renderer, StatsTracker& statsTracker)
+    void World::Init(Window* window, ResourceManager* resources, JobManager* jobs, Renderer* renderer, StatsTracker& statsTracker, const WorldProperties& properties)
     {
+        m_Properties = properties;
         m_Window = window;
         m_Resources = resources;
         m_Jobs = jobs;
@@ -53,26 +60,49 @@ namespace ThatEngine
         m_Registry.ctx().emplace<StatsTracker*>(m_StatsTracker);
         m_Registry.ctx().emplace<World*>(this);
 
+        // Cold transform data lives in its own storage, every transform gets one
+        m_Registry.on_construct<ECS::Transform>().connect<&ECS::Registry::emplace_or_replace<ECS::TransformMatrix>>();
+
+        // Every mesh owns a GPU instance slot for as long as it exists
+        m_Registry.on_construct<ECS::Mesh>().connect<&World::OnMeshConstruct>(this);
+        m_Registry.on_destroy<ECS::Mesh>().connect<&World::OnMeshDestroy>(this);
+
         // Register systems
-        m_SystemManager.AddSystem(ECS::UpdateScreenSpaceTransformSystem);
-        m_SystemManager.AddSystem(ECS::UpdateWorldSpaceTransformSystem);
-        m_SystemManager.AddSystem(ECS::CameraControlSystem);
-        m_SystemManager.AddSystem(ECS::UpdateCameraSystem);
-        m_SystemManager.AddSystem(ECS::UpdatePerformanceMonitorSystem);
-        m_SystemManager.AddSystem(ECS::WaveSystem);
-        m_SystemManager.AddSystem(ECS::RotateTextSystem);
+        m_SystemManager.AddSystem("Update Screen Space Transform", ECS::UpdateScreenSpaceTransformSystem,
+            ECS::Read<ECS::ScreenSpace, Window>{},
+            ECS::Write<ECS::Transform, ECS::TransformMatrix>{});
+        m_SystemManager.AddSystem("Update World Space Transform", ECS::UpdateWorldSpaceTransformSystem,
+            ECS::Read<ECS::WorldSpace, GlobalData>{},
+            ECS::Write<ECS::Transform, ECS::TransformMatrix>{});
+        m_SystemManager.AddSystem("Camera Control", ECS::CameraControlSystem,
+            ECS::Read<ECS::TransformMatrix, ECS::Camera, ECS::PlayerControl, Input, Window>{},
+            ECS::Write<ECS::Transform, ECS::Movement>{});
+        m_SystemManager.AddSystem("Follow Camera Path", ECS::FollowCameraPathSystem,
+            ECS::Read<>{},
+            ECS::Write<ECS::Transform, ECS::CameraPath>{});
+        m_SystemManager.AddSystem("Update Camera", ECS::UpdateCameraSystem,
+            ECS::Read<ECS::Transform, ECS::TransformMatrix, ECS::Camera, Window>{},
+            ECS::Write<GlobalData>{});
+        m_SystemManager.AddSystem("Update Performance Monitor", ECS::UpdatePerformanceMonitorSystem,
+            ECS::Read<ECS::PerformanceMonitor, StatsTracker, Input>{},
+            ECS::Write<ECS::Lifetime, ECS::Text, Renderer>{});
+        m_SystemManager.AddSystem("Wave", ECS::WaveSystem,
+            ECS::Read<ECS::Wave, GlobalData>{},
+            ECS::Write<ECS::Transform>{});
+        m_SystemManager.AddSystem("Rotate Text", ECS::RotateTextSystem,
+            ECS::Read<ECS::WorldSpace, ECS::Text>{},
+            ECS::Write<ECS::Transform>{});
+        m_SystemManager.Build();
 
         // Create entities
         CreatePlayer();
         CreateEnvironment();
         CreateUI();
-        
-        // Start the timer
-        m_Timer.Reset();
     }
 
     void World::Update(Timestep deltaTime)
     {
+        m_ElapsedTime += deltaTime.GetSeconds();
         m_SystemManager.Update(m_Registry, deltaTime);
         
         m_GlobalData.LightColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.2f);
@@ -80,51 +110,63 @@ namespace ThatEngine
         m_GlobalData.FogParams = glm::vec2(0.9f, 1.0f);
         m_GlobalData.SkyColor = glm::vec4(0.19f, 0.29f, 0.52f, 1.0f);
         m_GlobalData.RenderMode = static_cast<uint32_t>(m_Renderer->GetRenderMode());
-        m_GlobalData.Time = m_Timer.GetElapsedTime().GetSeconds();
+        m_GlobalData.Time = m_ElapsedTime;
 
         m_Renderer->UploadGlobalData(m_GlobalData);
     }
 
-    void World::UpdateViewProjection(const ECS::Transform& transform, const ECS::Camera& camera)
+    void World::UpdateViewProjection(const ECS::Transform& transform, const ECS::TransformMatrix& matrix, const ECS::Camera& camera)
     {
-        glm::mat4 view = glm::lookAt(transform.Position, transform.Position - transform.Forward, transform.Up);
+        glm::mat4 view = glm::lookAt(transform.Position, transform.Position - matrix.Forward, matrix.Up);
         
         m_GlobalData.ScreenSize = glm::vec4(m_Window->GetInnerWidth(), m_Window->GetInnerHeight(), camera.NearPlane, camera.FarPlane);
         m_GlobalData.PerspectiveViewProjection = glm::perspectiveFovLH(glm::radians(camera.Fov), m_GlobalData.ScreenSize.x, m_GlobalData.ScreenSize.y, camera.NearPlane, camera.FarPlane) * view;    
         m_GlobalData.OrthographicViewProjection = glm::orthoLH(0.0f, m_GlobalData.ScreenSize.x, 0.0f, m_GlobalData.ScreenSize.y, -1.0f, 1.0f);
     }
 
-    void World::UpdateRenderableDatapack()
+    void World::OnMeshConstruct(ECS::Registry& registry, ECS::Entity entity)
     {
-        m_RenderableDatapack.Clear();
+        auto& mesh = registry.get<ECS::Mesh>(entity);
+        mesh.InstanceSlot = m_Renderer->GetMeshInstanceStore().AllocateSlot(mesh.Type);
+    }
 
+    void World::OnMeshDestroy(ECS::Registry& registry, ECS::Entity entity)
+    {
+        auto& mesh = registry.get<ECS::Mesh>(entity);
+        m_Renderer->GetMeshInstanceStore().FreeSlot(mesh.InstanceSlot);
+        mesh.InstanceSlot = INVALID_UINT32_ID;
+    }
+
+    void World::UpdateRenderableDatapack(RenderableDatapack& datapack)
+    {
         // Clear color
-        m_RenderableDatapack.ClearColor = Utils::Color::ToLinear(m_GlobalData.SkyColor);
+        datapack.ClearColor = Utils::Color::ToLinear(m_GlobalData.SkyColor);
 
-        // Mesh instances
+        // Mesh instances stay on the GPU, only rebuilt ones are written to their slots
         {
-            auto view = m_Registry.view<ECS::Transform, ECS::WorldSpace, ECS::Mesh>();
+            auto view = m_Registry.view<ECS::Transform, ECS::TransformMatrix, ECS::WorldSpace, ECS::Mesh>();
+            MeshInstanceStore& meshInstances = m_Renderer->GetMeshInstanceStore();
 
-            view.each([&](auto entity, const auto& transform, const auto& mesh)
+            view.each([&](auto entity, const auto& transform, auto& matrix, const auto& mesh)
             {
-                if (!transform.IsVisible || !transform.IsActive) return;
+                if (!matrix.IsModelChanged) return;
 
-                const MeshInstance meshInstance { transform.Model };
-                m_RenderableDatapack.MeshInstanceBatches[mesh.Type].Instances.emplace_back(meshInstance);
+                meshInstances.UpdateSlot(mesh.InstanceSlot, matrix.Model, transform.BoundingRadius, transform.IsActive);
+                matrix.IsModelChanged = false;
             });
         }
 
         // Text glyph instances 
         {
             constexpr glm::vec3 shadowOffset = glm::vec3(0.0f, -1.0f, 0.0f);
-            auto view = m_Registry.view<ECS::Transform, ECS::Text>();
+            auto view = m_Registry.view<ECS::Transform, ECS::TransformMatrix, ECS::Text>();
 
-            view.each([&](auto entity, const auto& transform, const auto& text)
+            view.each([&](auto entity, const auto& transform, const auto& matrix, const auto& text)
             {
-                if (!transform.IsVisible || !transform.IsActive) return;
+                if (!transform.IsVisible || !transform.IsActive || !text.IsVisible) return;
                 
                 bool isScreenSpace = m_Registry.any_of<ECS::ScreenSpace>(entity);
-                auto& batchInstances = (isScreenSpace ? m_RenderableDatapack.ScreenSpaceGlyphInstanceBatches[text.Font] : m_RenderableDatapack.WorldSpaceGlyphInstanceBatches[text.Font]).Instances;
+                auto& batchInstances = (isScreenSpace ? datapack.ScreenSpaceGlyphInstanceBatches[text.Font] : datapack.WorldSpaceGlyphInstanceBatches[text.Font]).Instances;
                 
                 const Shared<FontAtlasData>& fontAtlasData = m_Resources->GetFontManager().GetFontAtlasData(text.Font);
                 const float atlasFontSize = fontAtlasData->FontSize;
@@ -148,7 +190,7 @@ namespace ThatEngine
                     float alignY = -(glyphData.Rect.w * 0.5f + glyphData.Offset.y) * fontSizeScaled;
 
                     glm::vec3 glyphPosition = glm::vec3(glyphOffset + alignX, alignY, 0.0f);
-                    glm::mat4 glyphModel = glm::translate(transform.Model, glyphPosition) * glyphScale;
+                    glm::mat4 glyphModel = glm::translate(matrix.Model, glyphPosition) * glyphScale;
                     GlyphInstance glyphInstance { glyphModel, glyphData.Rect, text.Color };
                     batchInstances.emplace_back(glyphInstance);
                     
@@ -156,7 +198,7 @@ namespace ThatEngine
                     if (isScreenSpace)
                     {
                         glm::vec3 shadowPosition = glyphPosition + shadowOffset;
-                        glm::mat4 shadowModel = glm::translate(transform.Model, shadowPosition) * glyphScale;
+                        glm::mat4 shadowModel = glm::translate(matrix.Model, shadowPosition) * glyphScale;
                         GlyphInstance shadowInstance { shadowModel, glyphData.Rect, Utils::Color::Black };
                         batchInstances.emplace_back(shadowInstance);
                     }
@@ -169,8 +211,11 @@ namespace ThatEngine
 
     void World::Render()
     {
-        UpdateRenderableDatapack();
-        m_Renderer->Render(m_RenderableDatapack);
+        // Lives in the frame arena, gone after the next frame allocator reset
+        RenderableDatapack* datapack = FrameAllocator::Get().Create<RenderableDatapack>(FrameAllocator::GetResource());
+
+        UpdateRenderableDatapack(*datapack);
+        m_Renderer->Render(*datapack);
     }
 
     void World::SetActiveCamera(ECS::Entity entity)
@@ -187,6 +232,26 @@ namespace ThatEngine
         m_Registry.emplace<ECS::Movement>(m_PlayerEntity);
         m_Registry.emplace<ECS::PlayerControl>(m_PlayerEntity);
 
+        // Loop around the middle of the environment, inside the camera's far plane
+        if (m_Properties.UseCameraPath)
+        {
+            constexpr uint32_t pointCount = 8;
+            const float radius = glm::min(m_Properties.EnvironmentGridSize * 0.5f * 0.4f, 40.0f);
+
+            ECS::CameraPath path = {};
+            path.Target = glm::vec3(0.0f);
+            path.Duration = 20.0f;
+
+            for (uint32_t i = 0; i < pointCount; i++)
+            {
+                float angle = glm::radians(360.0f * i / pointCount);
+                float height = 10.0f + 5.0f * glm::sin(angle * 2.0f);
+                path.Points.emplace_back(radius * glm::cos(angle), height, radius * glm::sin(angle));
+            }
+
+            m_Registry.emplace<ECS::CameraPath>(m_PlayerEntity, std::move(path));
+        }
+
         SetActiveCamera(m_PlayerEntity);
     }
 
@@ -194,11 +259,12 @@ namespace ThatEngine
     {
         // Wavy cube entities
         {
-            const uint32_t entityCount = static_cast<uint32_t>(m_EnvironmentEntities.size());
-            const uint32_t entityRowCount = static_cast<uint32_t>(glm::sqrt(entityCount));
+            const uint32_t entityRowCount = m_Properties.EnvironmentGridSize;
+            const uint32_t entityCount = entityRowCount * entityRowCount;
             const float entitySpacing = 0.5f; 
             const float entityOffset = entityRowCount * entitySpacing * 0.5f;
             
+            m_EnvironmentEntities.resize(entityCount);
             for (uint32_t i = 0; i < entityCount; i++)
             {
                 m_EnvironmentEntities[i] = m_Registry.create();
@@ -20,28 +20,41 @@
 #include "Types/ECSTypes.hpp"
 #include "World/System/SystemManager.hpp"
 #include "World/Component/Transform.hpp"
+#include "World/Component/TransformMatrix.hpp"
 #include "World/Component/Camera.hpp"
 
 #include <entt/entt.hpp>
 
 namespace ThatEngine
 {
+    struct WorldProperties
+    {
+        // Wavy cubes per side of the environment grid
+        uint32_t EnvironmentGridSize = 250;
+
+        // Player camera follows a scripted path around the environment instead of input
+        bool UseCameraPath = false;
+    };
+
     class World
     {
         public:
         World() = default;
 
-        void Init(Window* window, ResourceManager* resources, JobManager* jobs, Renderer* renderer, StatsTracker& statsTracker);
+        void Init(Window* window, ResourceManager* resources, JobManager* jobs, Renderer* renderer, StatsTracker& statsTracker, const WorldProperties& properties = {});
         void Update(Timestep time);
-        void UpdateViewProjection(const ECS::Transform& transform, const ECS::Camera& camera);
+        void UpdateViewProjection(const ECS::Transform& transform, const ECS::TransformMatrix& matrix, const ECS::Camera& camera);
         void Render();
 
         void SetActiveCamera(ECS::Entity entity);
         inline constexpr ECS::Entity GetActiveCamera() const { return m_ActiveCamera; }
         inline const GlobalData& GetGlobalData() const { return m_GlobalData; };
+        inline const ECS::SystemManager& GetSystemManager() const { return m_SystemManager; }
 
         private:
-        void UpdateRenderableDatapack();
+        void OnMeshConstruct(ECS::Registry& registry, ECS::Entity entity);
+        void OnMeshDestroy(ECS::Registry& registry, ECS::Entity entity);
+        void UpdateRenderableDatapack(RenderableDatapack& datapack);
         void CreatePlayer();
         void CreateEnvironment();
         void CreateUI();
@@ -56,15 +69,15 @@ namespace ThatEngine
         ECS::SystemManager m_SystemManager;
         
         // Data
-        RenderableDatapack m_RenderableDatapack;
+        WorldProperties m_Properties;
         GlobalData m_GlobalData;
-        Timer m_Timer;
+        float m_ElapsedTime = 0.0f; // Sum of frame delta times, so fixed timestep runs are repeatable
         ECS::Entity m_ActiveCamera;
 
         // World-space entities
         ECS::Entity m_PlayerEntity;
         ECS::Entity m_WorldSpaceTextEntity;
-        std::array<ECS::Entity, 250 * 250> m_EnvironmentEntities;
+        std::vector<ECS::Entity> m_EnvironmentEntities;
 
         // Screen-space entities (UI)
         ECS::Entity m_PerformanceMonitorEntity;
@@ -0,0 +1,81 @@
+#!/usr/bin/env bash
+# Linux build, mirrors build.bat with the same build_config.cfg, runs headless against any Vulkan driver such as lavapipe
+set -e
+cd "$(dirname "$0")"
+
+# Read variables from config file, Windows paths in it are not used here
+while IFS='=' read -r name value; do
+    [ -n "$name" ] && declare "$name=${value%$'\r'}"
+done < build_config.cfg
+
+CXX=${CXX:-g++}
+GLSLC=${GLSLC:-glslc}
+OUTPUT_DIR_OBJ=${OUTPUT_DIR_OBJ//\\//}/Linux
+OUTPUT_DIR_EXE=${OUTPUT_DIR_EXE//\\//}
+SHADER_ASSETS=${SHADER_ASSETS//\\//}
+TEXTURE_ASSETS=${TEXTURE_ASSETS//\\//}
+
+# Flags and defines, same switches as build_flags.bat
+CFLAGS="-c -Werror -std=c++23 -finput-charset=UTF-8"
+DEFINES="-D PLATFORM_LINUX -D $BUILD_MODE"
+
+if [ "${BUILD_MODE^^}" = "RELEASE" ]; then
+    CFLAGS="$CFLAGS -O2"
+    LFLAGS="-flto"
+else
+    CFLAGS="$CFLAGS -g"
+    LFLAGS=""
+fi
+
+[ "$USE_VULKAN_VALIDATION_LAYERS" = "true" ] && echo "USE_VULKAN_VALIDATION_LAYERS enabled" && DEFINES="$DEFINES -D VULKAN_VALIDATION_LAYERS"
+[ "$USE_TRACY" = "true" ] && echo "USE_TRACY enabled" && DEFINES="$DEFINES -D TRACY_ENABLE"
+[ "$RUN_MICROBENCHMARKS" = "true" ] && echo "RUN_MICROBENCHMARKS enabled" && DEFINES="$DEFINES -D MICROBENCHMARKS"
+[ "$USE_AVX2" = "true" ] && echo "USE_AVX2 enabled" && CFLAGS="$CFLAGS -mavx2 -mfma"
+[ "$USE_ALLOCATION_TRACKING" = "true" ] && echo "USE_ALLOCATION_TRACKING enabled" && DEFINES="$DEFINES -D ALLOCATION_TRACKING"
+
+INCLUDES="-I ./Source -I ./Source/Core -I ./Vendor/glm -I ./Vendor/spdlog/include -I ./Vendor/SPIRV-Reflect -I ./Vendor/stb -I ./Vendor/entt/src -I ./Vendor/tracy/public"
+[ -n "$VULKAN_SDK" ] && INCLUDES="$INCLUDES -I $VULKAN_SDK/include"
+LINKS="-lvulkan -lpthread -ldl"
+[ -n "$VULKAN_SDK" ] && LINKS="-L $VULKAN_SDK/lib $LINKS"
+
+echo "Building $APP_NAME in ${BUILD_MODE}_MODE:"
+mkdir -p "$OUTPUT_DIR_OBJ" "$OUTPUT_DIR_EXE"
+
+# Compile shaders
+echo "Compiling shaders to SPIR-V format:"
+find "$SHADER_ASSETS" -maxdepth 1 -type f ! -name "*.spv" | while read -r shader; do
+    echo "Compiling $shader"
+    "$GLSLC" "$shader" -o "$shader.spv"
+done
+
+# Convert textures, texconv only exists for Windows, run it through a wrapper if one is set
+echo; echo "Converting textures to DDS format:"
+if [ -n "$TEXCONV" ]; then
+    find "$TEXTURE_ASSETS" -type f ! -iname "*.dds" | while read -r texture; do
+        echo "Converting $texture"
+        $TEXCONV -f "$TEXTURE_FORMAT" -m 1 -y -o "$(dirname "$texture")" "$texture" > /dev/null 2>&1
+    done
+else
+    echo "TEXCONV is not set, textures are not converted"
+fi
+
+# Vendor sources, build.bat compiles these with the PCH
+OBJS=""
+for source in Vendor/SPIRV-Reflect/spirv_reflect.cpp Vendor/stb/stb_truetype.cpp Vendor/tracy/public/TracyClient.cpp; do
+    object="$OUTPUT_DIR_OBJ/$(basename "$source").o"
+    $CXX $CFLAGS $INCLUDES $DEFINES "$source" -o "$object"
+    OBJS="$OBJS $object"
+done
+
+# Application sources, every one includes the PCH header itself, platform code compiles to nothing without its PLATFORM_ define
+echo; echo "Gathering source files:"
+for source in $(find ./Source -name "*.cpp"); do
+    object="$OUTPUT_DIR_OBJ/$(basename "$source").o"
+    echo "$source"
+    $CXX $CFLAGS $INCLUDES $DEFINES "$source" -o "$object"
+    OBJS="$OBJS $object"
+done
+
+# Link everything
+echo; echo "Linking stuff together:"
+$CXX $LFLAGS $OBJS $LINKS -o "$OUTPUT_DIR_EXE/$APP_NAME"
@@ -28,4 +28,22 @@ if /I "!USE_TRACY!"=="true" (
     set "DEFINES=!DEFINES! /D TRACY_ENABLE"
 )
 
+:: Microbenchmarks define
+if /I "!RUN_MICROBENCHMARKS!"=="true" (
+    echo RUN_MICROBENCHMARKS enabled
+    set "DEFINES=!DEFINES! /D MICROBENCHMARKS"
+)
+
+:: AVX2 code generation, SIMD utils switch from 4 to 8 lanes
+if /I "!USE_AVX2!"=="true" (
+    echo USE_AVX2 enabled
+    set "CFLAGS=!CFLAGS! /arch:AVX2"
+)
+
+:: Allocation tracking define
+if /I "!USE_ALLOCATION_TRACKING!"=="true" (
+    echo USE_ALLOCATION_TRACKING enabled
+    set "DEFINES=!DEFINES! /D ALLOCATION_TRACKING"
+)
+
 endlocal & set "CFLAGS=%CFLAGS%" & set "DEFINES=%DEFINES%"
\ No newline at end of file